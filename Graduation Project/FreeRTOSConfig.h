@@ -50,6 +50,8 @@
 #define configMAX_PRIORITIES		( 4 )
 #define configMINIMAL_STACK_SIZE	( ( unsigned short ) 90 )
 #define configTOTAL_HEAP_SIZE		( ( size_t ) 13 * 1024 )
+/* Sample the task stacks from the idle task and recommend a stack size for each task. */
+#define configUSE_STACK_PROFILING	1
 #define configMAX_TASK_NAME_LEN		( 8 )
 #define configUSE_16_BIT_TICKS		0
 #define configIDLE_SHOULD_YIELD		1
@@ -59,6 +61,43 @@
 
 #if (configUSE_EDF_SCHEDULER == 1)
 		#define configUSE_PREEMPTION		1
+		/* Policy used to order xReadyTasksListEDF: tskPOLICY_RM, tskPOLICY_DM, tskPOLICY_EDF or tskPOLICY_LLF. */
+		#define configSCHEDULING_POLICY		tskPOLICY_EDF
+		/* Count context switches, deadline misses and kernel overhead to compare the policies. */
+		#define configUSE_SCHEDULER_STATS	1
+		/* Allow periods/deadlines to be changed at run time (xTaskSetPeriod/xTaskSetMode). */
+		#define configUSE_MODE_CHANGE		1
+		/* Stretch the periods of soft elastic tasks under overload (xTaskSetElastic/xTaskElasticAdjust). */
+		#define configUSE_ELASTIC_TASKS		1
+		/* Let tasks with an (m,k)-firm constraint skip jobs under overload (xTaskSetMKFirm). */
+		#define configUSE_MK_FIRM			1
+		/* Allow a job that misses its deadline to be aborted and its task restarted (xTaskSetAbortOnMiss). */
+		#define configUSE_ABORT_ON_MISS		1
+		/* Allow periodic run to completion jobs that share one stack (xTaskPeriodicJobCreate). */
+		#define configUSE_RUN_TO_COMPLETION_JOBS	1
+		#define configJOB_DISPATCHER_STACK_SIZE	configMINIMAL_STACK_SIZE	/* The heartbeat job and the status timer only toggle a pin. */
+		/* Software timers whose callbacks run by deadline on the job stack (xTaskDeadlineTimerCreate). */
+		#define configUSE_DEADLINE_TIMERS	1
+		/* Let tasks hold off preemption in bounded non-preemptive regions and set preemption thresholds. */
+		#define configUSE_LIMITED_PREEMPTION	1
+		/* Release tasks on a period in T1 counts from a one-shot MR0 match (xTaskSetHighResolutionPeriod). */
+		#define configUSE_HIGH_RESOLUTION_RELEASES	1
+		#define configHR_COUNTS_PER_TICK	( 1000UL )	/* T1 counts at 1 MHz, see configTimer1() in main.c. */
+		#define configHR_TIMER_COUNT()		( T1TC )
+		#define configHR_TIMER_SET_COMPARE( ulCount )	do { T1MR0 = ( ulCount ); T1MCR |= 0x1; } while( 0 )
+		#define configHR_TIMER_STOP_COMPARE()	( T1MCR &= ~0x1 )
+		/* Set to 1 to sort the jobs the tick releases into the ready list from the "REL" task instead of the tick ISR. */
+		#define configUSE_DEFERRED_RELEASES	0
+		/* Set to 1 to keep the ready jobs in deadline buckets found with a bitmap instead of one sorted list. */
+		#define configUSE_EDF_BUCKETS	0
+		/* Set to 1 to keep the keys of up to 16 ready tasks in an array scanned for the earliest (small task sets). */
+		#define configUSE_EDF_ARRAY	0
+		/* Allow tasks released from interrupts with a minimum inter-arrival time (xTaskSporadicCreate). */
+		#define configUSE_SPORADIC_TASKS	1
+		/* EDF-VD for tasks given a criticality and LO/HI budgets, a HI task past its LO budget switches to HI mode (xTaskSetCriticality). */
+		#define configUSE_MIXED_CRITICALITY	1
+		/* Set to 1 to call vApplicationBudgetOverrunHook() from the tick when a HI job runs past its HI budget, the overruns are counted either way. */
+		#define configUSE_BUDGET_OVERRUN_HOOK	0
 #endif
 
 #define configUSE_APPLICATION_TASK_TAG  1
@@ -82,14 +121,28 @@ to exclude the API function. */
 #define configUSE_TRACE_FACILITY                1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    1
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
-#define portGET_RUN_TIME_COUNTER_VALUE() (T1TC)
+/* T1 counts in microseconds for the high resolution releases, the run time stats keep their units (PCLK / 1001) and wrap after 19.9 hours, see getRunTimeCounter() in main.c. */
+extern unsigned int getRunTimeCounter( void );
+#define portGET_RUN_TIME_COUNTER_VALUE() getRunTimeCounter()
+/* Measure the kernel paths (vTaskGetKernelPathStats) and the kernel overhead (ulTaskGetKernelOverheadTime), in T1 counts (microseconds). */
+#define configUSE_KERNEL_BENCHMARK	1
+#define configBENCHMARK_COUNTER_VALUE() (T1TC)
+/* Measure interrupts masked / scheduler suspended sections (vTaskGetBlockingStats), in T1 counts (microseconds). */
+#define configUSE_BLOCKING_PROFILER	1
+#define configBLOCKING_PROFILER_COUNTER_VALUE() (T1TC)
+#define configBLOCKING_PROFILER_CALLER() ((uint32_t)__return_address())
 
 /* Trace Hook Macros */
 
+/* The times are T1 counts, the totals are summed from wrap-safe differences and do not wrap. */
 extern  float CPU_Load;
-extern  unsigned int Total_System_Time;
-extern  unsigned int Task1_In_Time,Task1_Out_Time,Task1_Total_Time;
-extern  unsigned int Task2_In_Time,Task2_Out_Time,Task2_Total_Time;
+extern  unsigned long long Total_System_Time;
+extern  unsigned int Last_Switch_Time;
+extern  unsigned int Task1_In_Time,Task1_Out_Time;
+extern  unsigned int Task2_In_Time,Task2_Out_Time;
+extern  unsigned long long Task1_Total_Time,Task2_Total_Time;
+extern  unsigned int Other_In_Time;
+extern  unsigned long long Other_Total_Time;
 
 /* 
  * Macro called after a task has been selected to run. 
@@ -97,7 +150,7 @@ extern  unsigned int Task2_In_Time,Task2_Out_Time,Task2_Total_Time;
  */
 #define traceTASK_SWITCHED_IN() do \
 																{ \
-																		if((int)pxCurrentTCB->pxTaskTag ==0)\
+																		if(pxCurrentTCB == xIdleTaskHandle)\
 																		{ \
 																				GPIO_write(PORT_0,PIN2,PIN_IS_HIGH); \
 																		} \
@@ -111,6 +164,10 @@ extern  unsigned int Task2_In_Time,Task2_Out_Time,Task2_Total_Time;
 																				GPIO_write(PORT_0,PIN4,PIN_IS_HIGH); \
 																				Task2_In_Time=T1TC; \
 																		} \
+																		else \
+																		{ \
+																				Other_In_Time=T1TC; \
+																		} \
 																}while(0)
 																
 		
@@ -120,24 +177,30 @@ extern  unsigned int Task2_In_Time,Task2_Out_Time,Task2_Total_Time;
  */																
 #define traceTASK_SWITCHED_OUT() do \
 																 { \
-																	 	if((int)pxCurrentTCB->pxTaskTag ==0) \
+																	 	unsigned int Switch_Time = T1TC; \
+																	 	if(pxCurrentTCB == xIdleTaskHandle) \
 																		{ \
 																				GPIO_write(PORT_0,PIN2,PIN_IS_LOW); \
 																		} \
 																		else if((int)pxCurrentTCB->pxTaskTag ==1) \
 																		{ \
 																				GPIO_write(PORT_0,PIN3,PIN_IS_LOW); \
-																				Task1_Out_Time = T1TC; \
-																				Task1_Total_Time += (Task1_Out_Time - Task1_In_Time); \
+																				Task1_Out_Time = Switch_Time; \
+																				Task1_Total_Time += (unsigned int)(Task1_Out_Time - Task1_In_Time); \
 																		} \
 																		else if((int)pxCurrentTCB->pxTaskTag ==2) \
 																		{ \
 																				GPIO_write(PORT_0,PIN4,PIN_IS_LOW); \
-																				Task2_Out_Time = T1TC; \
-																				Task2_Total_Time += (Task2_Out_Time - Task2_In_Time); \
+																				Task2_Out_Time = Switch_Time; \
+																				Task2_Total_Time += (unsigned int)(Task2_Out_Time - Task2_In_Time); \
+																		} \
+																		else \
+																		{ \
+																				Other_Total_Time += (unsigned int)(Switch_Time - Other_In_Time); \
 																		} \
-																		Total_System_Time=T1TC; \
-																		CPU_Load = (Task1_Total_Time + Task2_Total_Time)/(float)Total_System_Time; \
+																		Total_System_Time += (unsigned int)(Switch_Time - Last_Switch_Time); \
+																		Last_Switch_Time = Switch_Time; \
+																		CPU_Load = (Task1_Total_Time + Task2_Total_Time + Other_Total_Time)/(float)Total_System_Time; \
 																 }while(0)
 															 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,720 @@
+/*
+ * Partitioned and global EDF on a multi-core host.
+ *
+ * The kernel of this project runs one core, with one pxCurrentTCB and one EDF
+ * ready list.  This tool runs the same kind of periodic task sets on m host
+ * cores, one thread per core, each core with its own EDF ready queue.  Every
+ * task is placed on a core when it is created, by first fit or worst fit on
+ * its utilisation, and never leaves it.  The tasks are created by decreasing
+ * utilisation, so the placement is first fit or worst fit decreasing.  A core
+ * is then a single core EDF, which meets every deadline while the utilisation
+ * placed on it is at most 1, and the cores share no data at all.
+ *
+ * Global EDF has one ready queue, a deadline ordered heap shared by all the
+ * cores, and at any time the m earliest deadline jobs run, wherever they ran
+ * before.  Each core releases the jobs of its share of the tasks into the heap,
+ * holding the lock for the heap operation only.  Then the jobs are linked to
+ * the cores: while the top of the heap has an earlier deadline than the latest
+ * deadline running, it preempts that job, which goes back to the heap.  A job
+ * that then runs on another core than the last time has migrated.  The cores
+ * meet at a barrier between the releases, the linking and the tick of work.
+ *
+ * Time is counted in ticks.  Each job is a number of ticks of work, so a run
+ * is the same on any host, and the wall time per tick shows what the ready
+ * queues and the threads cost.
+ *
+ * Random task sets are drawn with UUniFast-Discard for a sweep of total
+ * utilisations U, with periods log-uniform between simMIN_PERIOD and
+ * simMAX_PERIOD and implicit deadlines.  For each U the report gives the
+ * share of the task sets each allocation could place, the share that ran
+ * with no deadline miss, the preemptions and migrations per job and the wall
+ * time per tick.  Every scheme runs the same task sets.  Global EDF places
+ * every task set, it may still miss deadlines above U = 1 even when the
+ * partitioned schemes do not.
+ *
+ * Build:  gcc -O2 -Wall -Wextra -pthread -o edf_smp_sim edf_smp_sim.c -lm
+ * Run:    ./edf_smp_sim [-m cores] [-n tasks] [-s sets] [-H ticks] [-r seed]
+ *
+ *   -m cores   number of cores, 4 by default.
+ *   -n tasks   tasks in each task set, 16 by default.
+ *   -s sets    task sets for each value of U, 20 by default.
+ *   -H ticks   how long each task set runs, 2000 ticks by default.
+ *   -r seed    seed of the task set generator, the same seed gives the same sets.
+ */
+
+#define _GNU_SOURCE
+
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define simMAX_CORES			16
+#define simMAX_TASKS			128
+#define simMIN_PERIOD			10.0		/* ticks */
+#define simMAX_PERIOD			1000.0		/* ticks */
+#define simDEFAULT_CORES		4
+#define simDEFAULT_TASKS		16
+#define simDEFAULT_SETS			20
+#define simDEFAULT_HORIZON		2000		/* ticks */
+#define simU_FIRST				0.50		/* Of the m cores, first step of the sweep. */
+#define simU_LAST				1.00
+#define simU_STEP				0.05
+
+typedef enum
+{
+	simFIRST_FIT = 0,
+	simWORST_FIT,
+	simGLOBAL,
+	simSCHEMES
+} SimScheme_t;
+
+static const char * const pcSchemeNames[ simSCHEMES ] = { "P-FF", "P-WF", "G" };
+
+typedef struct SimTask
+{
+	uint32_t ulWCET;			/* ticks */
+	uint32_t ulPeriod;			/* ticks, equal to the deadline. */
+	double dUtilisation;
+	uint32_t ulNextRelease;
+	int iCore;					/* The core the task was placed on, -1 if it did not fit.  With global EDF the core that releases its jobs. */
+} SimTask_t;
+
+typedef struct SimJob
+{
+	uint32_t ulDeadline;		/* Absolute. */
+	uint32_t ulRemaining;		/* ticks of work left. */
+	int iLastCore;				/* The core the job last ran on, -1 until it runs. */
+} SimJob_t;
+
+/* Binary min heap of jobs by absolute deadline, the EDF ready queue. */
+typedef struct SimHeap
+{
+	SimJob_t ** ppxJobs;
+	int iCount;
+	int iSize;
+} SimHeap_t;
+
+typedef struct SimCore
+{
+	SimHeap_t xReady;			/* Partitioned EDF only. */
+	SimJob_t * pxRunning;		/* With global EDF, written by any core under xGlobalLock while the jobs are linked. */
+	int iIndex;
+	double dLoad;				/* Utilisation placed on the core. */
+	int iTasks[ simMAX_TASKS ];	/* The tasks placed on the core. */
+	int iTaskCount;
+
+	/* Results. */
+	unsigned long ulJobs;
+	unsigned long ulMisses;
+	unsigned long ulPreemptions;
+	unsigned long ulMigrations;
+} SimCore_t;
+
+static SimTask_t xTasks[ simMAX_TASKS ];
+static int iTaskCount = 0;
+static SimCore_t xCores[ simMAX_CORES ];
+static int iCoreCount = simDEFAULT_CORES;
+static uint32_t ulHorizon = simDEFAULT_HORIZON;
+static uint64_t ullSeed = 1ULL;
+
+static SimHeap_t xGlobalReady;
+static pthread_mutex_t xGlobalLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_barrier_t xTickBarrier;
+
+/*-----------------------------------------------------------*/
+
+static int64_t prvNow( void )
+{
+	struct timespec xTime;
+
+	clock_gettime( CLOCK_MONOTONIC, &xTime );
+	return ( ( int64_t ) xTime.tv_sec * 1000000000LL ) + xTime.tv_nsec;
+}
+
+/* xorshift64*, uniform in [0, 1).  Only the main thread draws numbers. */
+static double prvRandom( void )
+{
+	ullSeed ^= ullSeed >> 12;
+	ullSeed ^= ullSeed << 25;
+	ullSeed ^= ullSeed >> 27;
+	return ( double ) ( ( ullSeed * 2685821657736338717ULL ) >> 11 ) / 9007199254740992.0;
+}
+
+/*-----------------------------------------------------------*/
+
+static void prvHeapPush( SimHeap_t * pxHeap, SimJob_t * pxJob )
+{
+	SimJob_t * pxParent;
+	int i;
+
+	if( pxHeap->iCount == pxHeap->iSize )
+	{
+		pxHeap->iSize = ( pxHeap->iSize > 0 ) ? ( pxHeap->iSize * 2 ) : 16;
+		pxHeap->ppxJobs = realloc( pxHeap->ppxJobs, ( size_t ) pxHeap->iSize * sizeof( SimJob_t * ) );
+
+		if( pxHeap->ppxJobs == NULL )
+		{
+			perror( "realloc" );
+			exit( 1 );
+		}
+	}
+
+	for( i = pxHeap->iCount++; i > 0; i = ( i - 1 ) / 2 )
+	{
+		pxParent = pxHeap->ppxJobs[ ( i - 1 ) / 2 ];
+
+		if( pxParent->ulDeadline <= pxJob->ulDeadline )
+		{
+			break;
+		}
+
+		pxHeap->ppxJobs[ i ] = pxParent;
+	}
+
+	pxHeap->ppxJobs[ i ] = pxJob;
+}
+
+static SimJob_t * prvHeapPop( SimHeap_t * pxHeap )
+{
+	SimJob_t * pxTop = pxHeap->ppxJobs[ 0 ];
+	SimJob_t * pxLast = pxHeap->ppxJobs[ --pxHeap->iCount ];
+	int i = 0, iChild;
+
+	for( ;; )
+	{
+		iChild = ( 2 * i ) + 1;
+
+		if( iChild >= pxHeap->iCount )
+		{
+			break;
+		}
+
+		if( ( ( iChild + 1 ) < pxHeap->iCount ) && ( pxHeap->ppxJobs[ iChild + 1 ]->ulDeadline < pxHeap->ppxJobs[ iChild ]->ulDeadline ) )
+		{
+			iChild++;
+		}
+
+		if( pxLast->ulDeadline <= pxHeap->ppxJobs[ iChild ]->ulDeadline )
+		{
+			break;
+		}
+
+		pxHeap->ppxJobs[ i ] = pxHeap->ppxJobs[ iChild ];
+		i = iChild;
+	}
+
+	if( pxHeap->iCount > 0 )
+	{
+		pxHeap->ppxJobs[ i ] = pxLast;
+	}
+
+	return pxTop;
+}
+
+/* The jobs still queued at the end of a run are misses if their deadline is
+ * within the run. */
+static unsigned long prvHeapDrain( SimHeap_t * pxHeap )
+{
+	unsigned long ulMisses = 0UL;
+	int i;
+
+	for( i = 0; i < pxHeap->iCount; i++ )
+	{
+		if( pxHeap->ppxJobs[ i ]->ulDeadline <= ulHorizon )
+		{
+			ulMisses++;
+		}
+
+		free( pxHeap->ppxJobs[ i ] );
+	}
+
+	pxHeap->iCount = 0;
+
+	return ulMisses;
+}
+
+/*-----------------------------------------------------------*/
+
+static SimJob_t * prvRelease( SimTask_t * pxTask, uint32_t ulTick )
+{
+	SimJob_t * pxJob = malloc( sizeof( SimJob_t ) );
+
+	if( pxJob == NULL )
+	{
+		perror( "malloc" );
+		exit( 1 );
+	}
+
+	pxJob->ulDeadline = ulTick + pxTask->ulPeriod;
+	pxJob->ulRemaining = pxTask->ulWCET;
+	pxJob->iLastCore = -1;
+	pxTask->ulNextRelease = ulTick + pxTask->ulPeriod;
+
+	return pxJob;
+}
+
+/* Runs the job of pxCore for the tick that starts at ulTick. */
+static void prvRunTick( SimCore_t * pxCore, uint32_t ulTick )
+{
+	SimJob_t * pxJob = pxCore->pxRunning;
+
+	if( pxJob != NULL )
+	{
+		if( ( pxJob->iLastCore >= 0 ) && ( pxJob->iLastCore != pxCore->iIndex ) )
+		{
+			pxCore->ulMigrations++;
+		}
+
+		pxJob->iLastCore = pxCore->iIndex;
+
+		if( --pxJob->ulRemaining == 0U )
+		{
+			/* Completes at the end of the tick. */
+			pxCore->ulJobs++;
+
+			if( ( ulTick + 1U ) > pxJob->ulDeadline )
+			{
+				pxCore->ulMisses++;
+			}
+
+			free( pxJob );
+			pxCore->pxRunning = NULL;
+		}
+	}
+}
+
+/*-----------------------------------------------------------*/
+
+/* One core of partitioned EDF.  It only touches its own tasks, ready queue
+ * and results, so it runs without a lock or a barrier. */
+static void * prvPartitionedCore( void * pvParameters )
+{
+	SimCore_t * pxCore = pvParameters;
+	SimTask_t * pxTask;
+	uint32_t ulTick;
+	int i;
+
+	for( ulTick = 0U; ulTick < ulHorizon; ulTick++ )
+	{
+		for( i = 0; i < pxCore->iTaskCount; i++ )
+		{
+			pxTask = &xTasks[ pxCore->iTasks[ i ] ];
+
+			if( pxTask->ulNextRelease == ulTick )
+			{
+				prvHeapPush( &pxCore->xReady, prvRelease( pxTask, ulTick ) );
+			}
+		}
+
+		/* The earliest deadline runs, a job is only preempted by one with a
+		 * strictly earlier deadline. */
+		if( ( pxCore->xReady.iCount > 0 ) &&
+			( ( pxCore->pxRunning == NULL ) || ( pxCore->xReady.ppxJobs[ 0 ]->ulDeadline < pxCore->pxRunning->ulDeadline ) ) )
+		{
+			if( pxCore->pxRunning != NULL )
+			{
+				prvHeapPush( &pxCore->xReady, pxCore->pxRunning );
+				pxCore->ulPreemptions++;
+			}
+
+			pxCore->pxRunning = prvHeapPop( &pxCore->xReady );
+		}
+
+		prvRunTick( pxCore, ulTick );
+	}
+
+	return NULL;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Links the earliest deadline jobs to the cores.  An idle core takes the top
+ * of the heap first, then the core running the latest deadline does, as long
+ * as the top is strictly earlier.  Called with xGlobalLock held, while no core
+ * runs a job. */
+static void prvGlobalLink( void )
+{
+	SimCore_t * pxLatest;
+	int i;
+
+	while( xGlobalReady.iCount > 0 )
+	{
+		pxLatest = &xCores[ 0 ];
+
+		for( i = 1; ( i < iCoreCount ) && ( pxLatest->pxRunning != NULL ); i++ )
+		{
+			if( ( xCores[ i ].pxRunning == NULL ) || ( xCores[ i ].pxRunning->ulDeadline > pxLatest->pxRunning->ulDeadline ) )
+			{
+				pxLatest = &xCores[ i ];
+			}
+		}
+
+		if( ( pxLatest->pxRunning != NULL ) && ( xGlobalReady.ppxJobs[ 0 ]->ulDeadline >= pxLatest->pxRunning->ulDeadline ) )
+		{
+			break;
+		}
+
+		if( pxLatest->pxRunning != NULL )
+		{
+			prvHeapPush( &xGlobalReady, pxLatest->pxRunning );
+			pxLatest->ulPreemptions++;
+		}
+
+		pxLatest->pxRunning = prvHeapPop( &xGlobalReady );
+	}
+}
+
+/* One core of global EDF. */
+static void * prvGlobalCore( void * pvParameters )
+{
+	SimCore_t * pxCore = pvParameters;
+	SimTask_t * pxTask;
+	SimJob_t * pxJob;
+	uint32_t ulTick;
+	int i;
+
+	for( ulTick = 0U; ulTick < ulHorizon; ulTick++ )
+	{
+		/* The job is made outside the lock, only the heap operation is in it. */
+		for( i = 0; i < pxCore->iTaskCount; i++ )
+		{
+			pxTask = &xTasks[ pxCore->iTasks[ i ] ];
+
+			if( pxTask->ulNextRelease == ulTick )
+			{
+				pxJob = prvRelease( pxTask, ulTick );
+				pthread_mutex_lock( &xGlobalLock );
+				prvHeapPush( &xGlobalReady, pxJob );
+				pthread_mutex_unlock( &xGlobalLock );
+			}
+		}
+
+		pthread_barrier_wait( &xTickBarrier );
+
+		/* The first core in links the jobs of every core, the others find
+		 * nothing left to do. */
+		pthread_mutex_lock( &xGlobalLock );
+		prvGlobalLink();
+		pthread_mutex_unlock( &xGlobalLock );
+
+		pthread_barrier_wait( &xTickBarrier );
+
+		prvRunTick( pxCore, ulTick );
+	}
+
+	return NULL;
+}
+
+/*-----------------------------------------------------------*/
+
+/* The allocation step of task creation: place the task on a core by first
+ * fit or worst fit, on the utilisation already placed on each core.  Returns
+ * the core, or -1 if the task does not fit on any. */
+static int prvPlaceTask( SimTask_t * pxTask, SimScheme_t xScheme )
+{
+	int i, iCore = -1;
+
+	for( i = 0; i < iCoreCount; i++ )
+	{
+		if( ( xCores[ i ].dLoad + pxTask->dUtilisation ) > ( 1.0 + 1e-9 ) )
+		{
+			continue;
+		}
+
+		if( iCore < 0 )
+		{
+			iCore = i;
+
+			if( xScheme == simFIRST_FIT )
+			{
+				break;
+			}
+		}
+		else if( xCores[ i ].dLoad < xCores[ iCore ].dLoad )
+		{
+			iCore = i;
+		}
+	}
+
+	if( iCore >= 0 )
+	{
+		xCores[ iCore ].dLoad += pxTask->dUtilisation;
+		xCores[ iCore ].iTasks[ xCores[ iCore ].iTaskCount++ ] = ( int ) ( pxTask - xTasks );
+	}
+
+	pxTask->iCore = iCore;
+
+	return iCore;
+}
+
+static int prvCompareUtilisation( const void * pvA, const void * pvB )
+{
+	const SimTask_t * pxA = pvA;
+	const SimTask_t * pxB = pvB;
+
+	return ( pxA->dUtilisation < pxB->dUtilisation ) - ( pxA->dUtilisation > pxB->dUtilisation );
+}
+
+/* UUniFast-Discard: iTasks utilisations that add up to dTotal, none above 1.
+ * The tasks are left sorted by decreasing utilisation, the order they are
+ * created in. */
+static void prvGenerateTaskSet( int iTasks, double dTotal )
+{
+	double dSum, dNext, dPeriod;
+	int i, iValid;
+
+	do
+	{
+		iValid = 1;
+		dSum = dTotal;
+
+		for( i = 0; i < ( iTasks - 1 ); i++ )
+		{
+			dNext = dSum * pow( prvRandom(), 1.0 / ( double ) ( iTasks - 1 - i ) );
+			xTasks[ i ].dUtilisation = dSum - dNext;
+			dSum = dNext;
+		}
+
+		xTasks[ iTasks - 1 ].dUtilisation = dSum;
+
+		for( i = 0; i < iTasks; i++ )
+		{
+			if( xTasks[ i ].dUtilisation > 1.0 )
+			{
+				iValid = 0;
+			}
+		}
+	} while( iValid == 0 );
+
+	for( i = 0; i < iTasks; i++ )
+	{
+		/* Whole ticks, so the utilisation is the one of the rounded WCET. */
+		dPeriod = exp( log( simMIN_PERIOD ) + ( prvRandom() * ( log( simMAX_PERIOD ) - log( simMIN_PERIOD ) ) ) );
+		xTasks[ i ].ulPeriod = ( uint32_t ) lround( dPeriod );
+		xTasks[ i ].ulWCET = ( uint32_t ) lround( xTasks[ i ].dUtilisation * ( double ) xTasks[ i ].ulPeriod );
+
+		if( xTasks[ i ].ulWCET == 0U )
+		{
+			xTasks[ i ].ulWCET = 1U;
+		}
+		else if( xTasks[ i ].ulWCET > xTasks[ i ].ulPeriod )
+		{
+			xTasks[ i ].ulWCET = xTasks[ i ].ulPeriod;
+		}
+
+		xTasks[ i ].dUtilisation = ( double ) xTasks[ i ].ulWCET / ( double ) xTasks[ i ].ulPeriod;
+	}
+
+	qsort( xTasks, ( size_t ) iTasks, sizeof( SimTask_t ), prvCompareUtilisation );
+	iTaskCount = iTasks;
+}
+
+/*-----------------------------------------------------------*/
+
+typedef struct SimResult
+{
+	unsigned long ulPlaced;		/* Task sets the allocation could place. */
+	unsigned long ulMet;		/* Task sets that ran with no deadline miss. */
+	unsigned long ulJobs;
+	unsigned long ulPreemptions;
+	unsigned long ulMigrations;
+	int64_t llTime;				/* ns of wall time for all the runs. */
+	uint64_t ullTicks;
+} SimResult_t;
+
+/* Runs the current task set under xScheme and adds the outcome to pxResult. */
+static void prvRunTaskSet( SimScheme_t xScheme, SimResult_t * pxResult )
+{
+	pthread_t xThreads[ simMAX_CORES ];
+	unsigned long ulMisses = 0UL;
+	int64_t llStart;
+	int i;
+
+	for( i = 0; i < iCoreCount; i++ )
+	{
+		xCores[ i ].pxRunning = NULL;
+		xCores[ i ].iIndex = i;
+		xCores[ i ].dLoad = 0.0;
+		xCores[ i ].iTaskCount = 0;
+		xCores[ i ].ulJobs = 0UL;
+		xCores[ i ].ulMisses = 0UL;
+		xCores[ i ].ulPreemptions = 0UL;
+		xCores[ i ].ulMigrations = 0UL;
+	}
+
+	for( i = 0; i < iTaskCount; i++ )
+	{
+		xTasks[ i ].ulNextRelease = 0U;
+
+		if( xScheme == simGLOBAL )
+		{
+			/* Any core can run the task, the releases are only shared out. */
+			xTasks[ i ].iCore = i % iCoreCount;
+			xCores[ i % iCoreCount ].iTasks[ xCores[ i % iCoreCount ].iTaskCount++ ] = i;
+		}
+		else if( prvPlaceTask( &xTasks[ i ], xScheme ) < 0 )
+		{
+			/* The task set does not fit, it is not run. */
+			return;
+		}
+	}
+
+	if( xScheme == simGLOBAL )
+	{
+		pthread_barrier_init( &xTickBarrier, NULL, ( unsigned ) iCoreCount );
+	}
+
+	pxResult->ulPlaced++;
+	llStart = prvNow();
+
+	for( i = 0; i < iCoreCount; i++ )
+	{
+		if( pthread_create( &xThreads[ i ], NULL, ( xScheme == simGLOBAL ) ? prvGlobalCore : prvPartitionedCore, &xCores[ i ] ) != 0 )
+		{
+			fprintf( stderr, "can not create the thread of core %d\n", i );
+			exit( 1 );
+		}
+	}
+
+	for( i = 0; i < iCoreCount; i++ )
+	{
+		pthread_join( xThreads[ i ], NULL );
+	}
+
+	pxResult->llTime += prvNow() - llStart;
+	pxResult->ullTicks += ulHorizon;
+
+	if( xScheme == simGLOBAL )
+	{
+		pthread_barrier_destroy( &xTickBarrier );
+		ulMisses += prvHeapDrain( &xGlobalReady );
+	}
+
+	for( i = 0; i < iCoreCount; i++ )
+	{
+		if( xCores[ i ].pxRunning != NULL )
+		{
+			xCores[ i ].ulMisses += ( xCores[ i ].pxRunning->ulDeadline <= ulHorizon ) ? 1UL : 0UL;
+			free( xCores[ i ].pxRunning );
+		}
+
+		ulMisses += xCores[ i ].ulMisses + prvHeapDrain( &xCores[ i ].xReady );
+		pxResult->ulJobs += xCores[ i ].ulJobs;
+		pxResult->ulPreemptions += xCores[ i ].ulPreemptions;
+		pxResult->ulMigrations += xCores[ i ].ulMigrations;
+	}
+
+	if( ulMisses == 0UL )
+	{
+		pxResult->ulMet++;
+	}
+}
+
+/*-----------------------------------------------------------*/
+
+int main( int argc, char ** argv )
+{
+	SimResult_t xResults[ simSCHEMES ];
+	int iTasks = simDEFAULT_TASKS, iSets = simDEFAULT_SETS;
+	int iOption, iSet, iStep, iSteps;
+	double dShare;
+	SimScheme_t xScheme;
+
+	while( ( iOption = getopt( argc, argv, "m:n:s:H:r:" ) ) != -1 )
+	{
+		switch( iOption )
+		{
+			case 'm':
+				iCoreCount = atoi( optarg );
+				break;
+
+			case 'n':
+				iTasks = atoi( optarg );
+				break;
+
+			case 's':
+				iSets = atoi( optarg );
+				break;
+
+			case 'H':
+				ulHorizon = ( uint32_t ) strtoul( optarg, NULL, 10 );
+				break;
+
+			case 'r':
+				ullSeed = strtoull( optarg, NULL, 10 );
+				break;
+
+			default:
+				fprintf( stderr, "usage: %s [-m cores] [-n tasks] [-s sets] [-H ticks] [-r seed]\n", argv[ 0 ] );
+				return 2;
+		}
+	}
+
+	if( ( iCoreCount < 1 ) || ( iCoreCount > simMAX_CORES ) || ( iTasks < 2 ) || ( iTasks > simMAX_TASKS ) ||
+		( iSets < 1 ) || ( ulHorizon == 0U ) )
+	{
+		fprintf( stderr, "need 1 <= cores <= %d, 2 <= tasks <= %d, sets >= 1 and ticks >= 1\n", simMAX_CORES, simMAX_TASKS );
+		return 2;
+	}
+
+	if( ullSeed == 0ULL )
+	{
+		/* xorshift never leaves 0. */
+		ullSeed = 1ULL;
+	}
+
+	printf( "%d cores, %d tasks, %d sets for each U, %lu ticks, periods %.0f..%.0f ticks\n", iCoreCount, iTasks, iSets,
+			( unsigned long ) ulHorizon, simMIN_PERIOD, simMAX_PERIOD );
+	printf( "%6s", "U/m" );
+
+	for( xScheme = simFIRST_FIT; xScheme < simSCHEMES; xScheme++ )
+	{
+		printf( " | %-4s %6s %6s %7s %7s %8s", pcSchemeNames[ xScheme ], "placed", "met", "pre/job", "mig/job", "us/tick" );
+	}
+
+	printf( "\n" );
+
+	iSteps = ( int ) lround( ( simU_LAST - simU_FIRST ) / simU_STEP );
+
+	for( iStep = 0; iStep <= iSteps; iStep++ )
+	{
+		dShare = simU_FIRST + ( ( double ) iStep * simU_STEP );
+		memset( xResults, 0, sizeof( xResults ) );
+
+		for( iSet = 0; iSet < iSets; iSet++ )
+		{
+			/* Every scheme runs the same task set. */
+			prvGenerateTaskSet( iTasks, dShare * ( double ) iCoreCount );
+
+			for( xScheme = simFIRST_FIT; xScheme < simSCHEMES; xScheme++ )
+			{
+				prvRunTaskSet( xScheme, &xResults[ xScheme ] );
+			}
+		}
+
+		printf( "%6.2f", dShare );
+
+		for( xScheme = simFIRST_FIT; xScheme < simSCHEMES; xScheme++ )
+		{
+			const SimResult_t * pxResult = &xResults[ xScheme ];
+
+			printf( " | %-4s %5.0f%% %5.0f%% %7.3f %7.3f %8.3f", "",
+					100.0 * ( double ) pxResult->ulPlaced / ( double ) iSets,
+					100.0 * ( double ) pxResult->ulMet / ( double ) iSets,
+					( pxResult->ulJobs > 0UL ) ? ( double ) pxResult->ulPreemptions / ( double ) pxResult->ulJobs : 0.0,
+					( pxResult->ulJobs > 0UL ) ? ( double ) pxResult->ulMigrations / ( double ) pxResult->ulJobs : 0.0,
+					( pxResult->ullTicks > 0ULL ) ? ( double ) pxResult->llTime / 1000.0 / ( double ) pxResult->ullTicks : 0.0 );
+		}
+
+		printf( "\n" );
+	}
+
+	printf( "placed: task sets the allocation could place, met: task sets that ran with no deadline miss\n" );
+
+	return 0;
+}
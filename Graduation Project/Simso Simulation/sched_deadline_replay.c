@@ -0,0 +1,503 @@
+/*
+ * SCHED_DEADLINE replay of an EDF task set on Linux.
+ *
+ * Runs the periodic tasks of a SimSo model (the XML files in this folder), or
+ * tasks given on the command line, as Linux SCHED_DEADLINE threads.  Each job
+ * is a busy loop calibrated to the WCET of its task, like the 100000 iteration
+ * loops of Task1 and Task2 in main.c, so the same task set can be compared with
+ * the SimSo results and with the CS/M1/M2 lines the board sends on the UART.
+ *
+ * Build:  gcc -O2 -pthread -o sched_deadline_replay sched_deadline_replay.c
+ * Run:    sudo ./sched_deadline_replay [-d ms] [-m margin%] [-u] "EDF Scheduler.xml"
+ *         sudo ./sched_deadline_replay [-d ms] -t Task1:15.1:60 -t Task2:15.28:80
+ *
+ *   -t name:C:T[:D]  a task with WCET C, period T and deadline D in ms (D = T if left out).
+ *   -d ms            how long to run, the duration of the SimSo model by default.
+ *   -m margin%       runtime given to SCHED_DEADLINE above the WCET, 5% by default.
+ *   -u               run without SCHED_DEADLINE (no root needed, no guarantees).
+ *
+ * SCHED_DEADLINE is global EDF over the CPUs of its root domain, and a deadline
+ * thread can not be pinned to fewer of them.  To compare with the single core
+ * board run the tool in an exclusive cpuset with one CPU, for instance
+ * "cset shield -c 1 -k on" then "cset shield -e ./sched_deadline_replay ...".
+ *
+ * For each task the report gives the number of jobs and deadline misses, the
+ * response time (completion - release) and the release latency (wake up -
+ * release), the part of the overhead Linux adds to each job, and the number of
+ * times the task was preempted.
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+
+#ifndef SCHED_DEADLINE
+	#define SCHED_DEADLINE	6
+#endif
+
+/* Not in every C library, the layout is the one of the kernel ABI. */
+struct replay_sched_attr
+{
+	uint32_t size;
+	uint32_t sched_policy;
+	uint64_t sched_flags;
+	int32_t sched_nice;
+	uint32_t sched_priority;
+	uint64_t sched_runtime;
+	uint64_t sched_deadline;
+	uint64_t sched_period;
+};
+
+#define replayMAX_TASKS			32
+#define replayNAME_LEN			24
+#define replayNS_PER_MS			1000000LL
+#define replayDEFAULT_DURATION	2000.0		/* ms, the duration of the models in this folder. */
+#define replayDEFAULT_MARGIN	5.0			/* % */
+#define replaySTART_DELAY		100			/* ms between creating the threads and the first release. */
+
+typedef struct ReplayTask
+{
+	char acName[ replayNAME_LEN ];
+	double dWCET;				/* ms */
+	double dPeriod;				/* ms */
+	double dDeadline;			/* ms */
+	unsigned long ulLoops;		/* Busy loop iterations of one job. */
+
+	/* Results. */
+	unsigned long ulJobs;
+	unsigned long ulMisses;
+	int64_t llResponseMin;		/* ns */
+	int64_t llResponseMax;
+	int64_t llResponseSum;
+	int64_t llLatencyMax;
+	int64_t llLatencySum;
+	long lPreemptions;
+	int iError;
+} ReplayTask_t;
+
+static ReplayTask_t xTasks[ replayMAX_TASKS ];
+static int iTaskCount = 0;
+static int64_t llStartTime;			/* ns, CLOCK_MONOTONIC time of the first release. */
+static int64_t llEndTime;
+static double dMargin = replayDEFAULT_MARGIN;
+static int iUseDeadline = 1;
+
+/*-----------------------------------------------------------*/
+
+static int64_t prvNow( void )
+{
+	struct timespec xTime;
+
+	clock_gettime( CLOCK_MONOTONIC, &xTime );
+	return ( ( int64_t ) xTime.tv_sec * 1000000000LL ) + xTime.tv_nsec;
+}
+
+static void prvSleepUntil( int64_t llTime )
+{
+	struct timespec xTime;
+
+	xTime.tv_sec = ( time_t ) ( llTime / 1000000000LL );
+	xTime.tv_nsec = ( long ) ( llTime % 1000000000LL );
+
+	while( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &xTime, NULL ) == EINTR )
+	{
+	}
+}
+
+static void prvBusyLoop( unsigned long ulLoops )
+{
+	/* Keeps the loop from being optimised away.  It is on the stack of the
+	 * calling thread, so the threads do not share, or race on, one variable. */
+	volatile unsigned long ulSink = 0UL;
+	unsigned long i;
+
+	for( i = 0; i < ulLoops; i++ )
+	{
+		ulSink = ulSink + i;
+	}
+}
+
+/*-----------------------------------------------------------*/
+
+/* Iterations of prvBusyLoop() per ms, the fastest of a few runs so a run that
+ * was preempted does not count. */
+static double prvCalibrate( void )
+{
+	const unsigned long ulLoops = 2000000UL;
+	int64_t llBest = INT64_MAX, llTime;
+	int i;
+
+	for( i = 0; i < 10; i++ )
+	{
+		llTime = prvNow();
+		prvBusyLoop( ulLoops );
+		llTime = prvNow() - llTime;
+
+		if( llTime < llBest )
+		{
+			llBest = llTime;
+		}
+	}
+
+	return ( double ) ulLoops * ( double ) replayNS_PER_MS / ( double ) llBest;
+}
+
+/*-----------------------------------------------------------*/
+
+static int prvAddTask( const char * pcName, double dWCET, double dPeriod, double dDeadline )
+{
+	ReplayTask_t * pxTask;
+
+	if( iTaskCount >= replayMAX_TASKS )
+	{
+		fprintf( stderr, "too many tasks, at most %d\n", replayMAX_TASKS );
+		return -1;
+	}
+
+	if( ( dWCET <= 0.0 ) || ( dPeriod <= 0.0 ) || ( dDeadline < dWCET ) )
+	{
+		fprintf( stderr, "%s: need 0 < C <= D and T > 0\n", pcName );
+		return -1;
+	}
+
+	pxTask = &xTasks[ iTaskCount++ ];
+	memset( pxTask, 0, sizeof( *pxTask ) );
+	snprintf( pxTask->acName, sizeof( pxTask->acName ), "%s", pcName );
+	pxTask->dWCET = dWCET;
+	pxTask->dPeriod = dPeriod;
+	pxTask->dDeadline = dDeadline;
+	pxTask->llResponseMin = INT64_MAX;
+
+	return 0;
+}
+
+/* -t name:C:T[:D] */
+static int prvParseTaskArgument( char * pcArgument )
+{
+	char * pcName = strtok( pcArgument, ":" );
+	char * pcWCET = strtok( NULL, ":" );
+	char * pcPeriod = strtok( NULL, ":" );
+	char * pcDeadline = strtok( NULL, ":" );
+
+	if( ( pcName == NULL ) || ( pcWCET == NULL ) || ( pcPeriod == NULL ) )
+	{
+		fprintf( stderr, "-t expects name:C:T[:D]\n" );
+		return -1;
+	}
+
+	return prvAddTask( pcName, atof( pcWCET ), atof( pcPeriod ), ( pcDeadline != NULL ) ? atof( pcDeadline ) : atof( pcPeriod ) );
+}
+
+/*-----------------------------------------------------------*/
+
+/* The value of attribute pcAttribute in the element that starts at pcElement
+ * and ends at pcEnd, NULL if it has none. */
+static const char * prvAttribute( const char * pcElement, const char * pcEnd, const char * pcAttribute, char * pcValue, size_t xSize )
+{
+	char acPattern[ 32 ];
+	const char * pcFound;
+	size_t xLength = 0;
+
+	snprintf( acPattern, sizeof( acPattern ), " %s=\"", pcAttribute );
+	pcFound = strstr( pcElement, acPattern );
+
+	if( ( pcFound == NULL ) || ( pcFound > pcEnd ) )
+	{
+		return NULL;
+	}
+
+	pcFound += strlen( acPattern );
+
+	while( ( pcFound[ xLength ] != '"' ) && ( pcFound[ xLength ] != '\0' ) && ( xLength < ( xSize - 1 ) ) )
+	{
+		pcValue[ xLength ] = pcFound[ xLength ];
+		xLength++;
+	}
+
+	pcValue[ xLength ] = '\0';
+	return pcValue;
+}
+
+/* Reads the periodic tasks and the duration of a SimSo model, only the
+ * attributes this tool needs are looked at. */
+static int prvLoadSimSo( const char * pcFile, double * pdDuration )
+{
+	FILE * pxFile;
+	char * pcText, * pcElement, * pcEnd;
+	char acValue[ 64 ], acName[ replayNAME_LEN ];
+	double dCyclesPerMs = 0.0;
+	long lSize;
+
+	pxFile = fopen( pcFile, "rb" );
+
+	if( pxFile == NULL )
+	{
+		perror( pcFile );
+		return -1;
+	}
+
+	fseek( pxFile, 0, SEEK_END );
+	lSize = ftell( pxFile );
+	fseek( pxFile, 0, SEEK_SET );
+	pcText = malloc( ( size_t ) lSize + 1 );
+
+	if( ( pcText == NULL ) || ( fread( pcText, 1, ( size_t ) lSize, pxFile ) != ( size_t ) lSize ) )
+	{
+		fprintf( stderr, "%s: can not read\n", pcFile );
+		fclose( pxFile );
+		free( pcText );
+		return -1;
+	}
+
+	pcText[ lSize ] = '\0';
+	fclose( pxFile );
+
+	pcElement = strstr( pcText, "<simulation " );
+
+	if( pcElement != NULL )
+	{
+		pcEnd = strchr( pcElement, '>' );
+
+		if( prvAttribute( pcElement, pcEnd, "cycles_per_ms", acValue, sizeof( acValue ) ) != NULL )
+		{
+			dCyclesPerMs = atof( acValue );
+		}
+
+		if( ( dCyclesPerMs > 0.0 ) && ( prvAttribute( pcElement, pcEnd, "duration", acValue, sizeof( acValue ) ) != NULL ) )
+		{
+			*pdDuration = atof( acValue ) / dCyclesPerMs;
+		}
+	}
+
+	for( pcElement = strstr( pcText, "<task " ); pcElement != NULL; pcElement = strstr( pcEnd, "<task " ) )
+	{
+		double dWCET, dPeriod, dDeadline;
+
+		pcEnd = strchr( pcElement, '>' );
+
+		if( pcEnd == NULL )
+		{
+			break;
+		}
+
+		if( ( prvAttribute( pcElement, pcEnd, "task_type", acValue, sizeof( acValue ) ) != NULL ) && ( strcmp( acValue, "Periodic" ) != 0 ) )
+		{
+			fprintf( stderr, "%s: skipping a %s task, only periodic tasks are replayed\n", pcFile, acValue );
+			continue;
+		}
+
+		if( prvAttribute( pcElement, pcEnd, "name", acName, sizeof( acName ) ) == NULL )
+		{
+			snprintf( acName, sizeof( acName ), "T%d", iTaskCount + 1 );
+		}
+
+		dWCET = ( prvAttribute( pcElement, pcEnd, "WCET", acValue, sizeof( acValue ) ) != NULL ) ? atof( acValue ) : 0.0;
+		dPeriod = ( prvAttribute( pcElement, pcEnd, "period", acValue, sizeof( acValue ) ) != NULL ) ? atof( acValue ) : 0.0;
+		dDeadline = ( prvAttribute( pcElement, pcEnd, "deadline", acValue, sizeof( acValue ) ) != NULL ) ? atof( acValue ) : dPeriod;
+
+		if( prvAddTask( acName, dWCET, dPeriod, dDeadline ) != 0 )
+		{
+			free( pcText );
+			return -1;
+		}
+	}
+
+	free( pcText );
+	return 0;
+}
+
+/*-----------------------------------------------------------*/
+
+static void * prvTaskThread( void * pvParameters )
+{
+	ReplayTask_t * pxTask = ( ReplayTask_t * ) pvParameters;
+	const int64_t llPeriod = ( int64_t ) ( pxTask->dPeriod * replayNS_PER_MS );
+	const int64_t llDeadline = ( int64_t ) ( pxTask->dDeadline * replayNS_PER_MS );
+	int64_t llRelease = llStartTime, llWake, llEnd;
+	struct replay_sched_attr xAttr;
+	struct rusage xUsage;
+
+	if( iUseDeadline != 0 )
+	{
+		memset( &xAttr, 0, sizeof( xAttr ) );
+		xAttr.size = sizeof( xAttr );
+		xAttr.sched_policy = SCHED_DEADLINE;
+		xAttr.sched_runtime = ( uint64_t ) ( pxTask->dWCET * ( 1.0 + ( dMargin / 100.0 ) ) * replayNS_PER_MS );
+		xAttr.sched_deadline = ( uint64_t ) llDeadline;
+		xAttr.sched_period = ( uint64_t ) llPeriod;
+
+		/* The runtime can not be more than the deadline. */
+		if( xAttr.sched_runtime > xAttr.sched_deadline )
+		{
+			xAttr.sched_runtime = xAttr.sched_deadline;
+		}
+
+		if( syscall( SYS_sched_setattr, 0, &xAttr, 0 ) != 0 )
+		{
+			pxTask->iError = errno;
+			return NULL;
+		}
+	}
+
+	while( llRelease < llEndTime )
+	{
+		prvSleepUntil( llRelease );
+		llWake = prvNow();
+
+		prvBusyLoop( pxTask->ulLoops );
+
+		llEnd = prvNow();
+		pxTask->ulJobs++;
+
+		if( llEnd > ( llRelease + llDeadline ) )
+		{
+			pxTask->ulMisses++;
+		}
+
+		if( ( llEnd - llRelease ) < pxTask->llResponseMin )
+		{
+			pxTask->llResponseMin = llEnd - llRelease;
+		}
+
+		if( ( llEnd - llRelease ) > pxTask->llResponseMax )
+		{
+			pxTask->llResponseMax = llEnd - llRelease;
+		}
+
+		pxTask->llResponseSum += llEnd - llRelease;
+
+		if( ( llWake - llRelease ) > pxTask->llLatencyMax )
+		{
+			pxTask->llLatencyMax = llWake - llRelease;
+		}
+
+		pxTask->llLatencySum += llWake - llRelease;
+
+		/* Releases stay on the nominal grid, a late job does not move the next one. */
+		llRelease += llPeriod;
+	}
+
+	getrusage( RUSAGE_THREAD, &xUsage );
+	pxTask->lPreemptions = xUsage.ru_nivcsw;
+
+	return NULL;
+}
+
+/*-----------------------------------------------------------*/
+
+int main( int argc, char ** argv )
+{
+	pthread_t xThreads[ replayMAX_TASKS ];
+	double dDuration = replayDEFAULT_DURATION, dDurationArgument = 0.0, dLoopsPerMs, dUtilisation = 0.0;
+	int iOption, i, iFailed = 0;
+
+	while( ( iOption = getopt( argc, argv, "t:d:m:u" ) ) != -1 )
+	{
+		switch( iOption )
+		{
+			case 't':
+				if( prvParseTaskArgument( optarg ) != 0 )
+				{
+					return 2;
+				}
+				break;
+
+			case 'd':
+				dDurationArgument = atof( optarg );
+				break;
+
+			case 'm':
+				dMargin = atof( optarg );
+				break;
+
+			case 'u':
+				iUseDeadline = 0;
+				break;
+
+			default:
+				fprintf( stderr, "usage: %s [-d ms] [-m margin%%] [-u] [-t name:C:T[:D]]... [simso.xml]\n", argv[ 0 ] );
+				return 2;
+		}
+	}
+
+	if( ( optind < argc ) && ( prvLoadSimSo( argv[ optind ], &dDuration ) != 0 ) )
+	{
+		return 2;
+	}
+
+	if( dDurationArgument > 0.0 )
+	{
+		dDuration = dDurationArgument;
+	}
+
+	if( iTaskCount == 0 )
+	{
+		fprintf( stderr, "no tasks, give a SimSo model or -t\n" );
+		return 2;
+	}
+
+	dLoopsPerMs = prvCalibrate();
+
+	for( i = 0; i < iTaskCount; i++ )
+	{
+		xTasks[ i ].ulLoops = ( unsigned long ) ( xTasks[ i ].dWCET * dLoopsPerMs );
+		dUtilisation += xTasks[ i ].dWCET / xTasks[ i ].dPeriod;
+	}
+
+	printf( "%d tasks, U = %.3f, %.0f ms, %.0f loops/ms, %s\n", iTaskCount, dUtilisation, dDuration, dLoopsPerMs,
+			( iUseDeadline != 0 ) ? "SCHED_DEADLINE" : "SCHED_OTHER" );
+
+	llStartTime = prvNow() + ( replaySTART_DELAY * replayNS_PER_MS );
+	llEndTime = llStartTime + ( int64_t ) ( dDuration * replayNS_PER_MS );
+
+	for( i = 0; i < iTaskCount; i++ )
+	{
+		if( pthread_create( &xThreads[ i ], NULL, prvTaskThread, &xTasks[ i ] ) != 0 )
+		{
+			fprintf( stderr, "%s: can not create its thread\n", xTasks[ i ].acName );
+			return 1;
+		}
+	}
+
+	for( i = 0; i < iTaskCount; i++ )
+	{
+		pthread_join( xThreads[ i ], NULL );
+	}
+
+	printf( "%-*s %8s %8s %8s %6s %6s %9s %9s %9s %9s %9s %6s\n", replayNAME_LEN, "task", "C", "T", "D",
+			"jobs", "miss", "resp min", "resp avg", "resp max", "lat avg", "lat max", "preempt" );
+
+	for( i = 0; i < iTaskCount; i++ )
+	{
+		const ReplayTask_t * pxTask = &xTasks[ i ];
+
+		if( pxTask->iError != 0 )
+		{
+			/* EPERM without root, EBUSY if the kernel does not admit the bandwidth. */
+			printf( "%-*s SCHED_DEADLINE refused: %s\n", replayNAME_LEN, pxTask->acName, strerror( pxTask->iError ) );
+			iFailed = 1;
+			continue;
+		}
+
+		printf( "%-*s %8.2f %8.2f %8.2f %6lu %6lu %9.3f %9.3f %9.3f %9.3f %9.3f %6ld\n", replayNAME_LEN, pxTask->acName,
+				pxTask->dWCET, pxTask->dPeriod, pxTask->dDeadline, pxTask->ulJobs, pxTask->ulMisses,
+				( pxTask->ulJobs > 0 ) ? ( double ) pxTask->llResponseMin / replayNS_PER_MS : 0.0,
+				( pxTask->ulJobs > 0 ) ? ( double ) pxTask->llResponseSum / ( double ) pxTask->ulJobs / replayNS_PER_MS : 0.0,
+				( double ) pxTask->llResponseMax / replayNS_PER_MS,
+				( pxTask->ulJobs > 0 ) ? ( double ) pxTask->llLatencySum / ( double ) pxTask->ulJobs / replayNS_PER_MS : 0.0,
+				( double ) pxTask->llLatencyMax / replayNS_PER_MS, pxTask->lPreemptions );
+	}
+
+	printf( "times in ms\n" );
+
+	return iFailed;
+}
@@ -0,0 +1,26 @@
+	INCLUDE portmacro.inc
+
+	IMPORT	vButtonISRHandler
+	EXPORT	vButtonISREntry
+
+	;/* Button (EINT0) interrupt entry point.  The task context is saved
+	;before the handler runs as it may release the button task, which can
+	;preempt the interrupted one. */
+
+	ARM
+	AREA	|.text|, CODE, READONLY
+
+vButtonISREntry
+
+	PRESERVE8
+
+	; Save the context of the interrupted task.
+	portSAVE_CONTEXT
+
+	; Call the C handler, which calls vTaskSwitchContext() if required.
+	BL	vButtonISRHandler
+
+	; Restore the context of the task selected to execute.
+	portRESTORE_CONTEXT
+
+	END
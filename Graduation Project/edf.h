@@ -0,0 +1,442 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Periodic tasks of the EDF scheduler and the statistics kept on them,
+ * implemented in tasks.c.  Include after task.h.  Each function is only
+ * built when the configuration option named next to it is set.
+ */
+
+#ifndef INC_EDF_H
+#define INC_EDF_H
+
+#ifndef INC_TASK_H
+	#error "include FreeRTOS.h and task.h must appear in source files before include edf.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+	extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/*-----------------------------------------------------------
+ * PERIODIC TASKS (configUSE_EDF_SCHEDULER)
+ *----------------------------------------------------------*/
+
+/*
+ * Create a task released every xTaskPeriod ticks, with an implicit deadline.
+ * The task ends each job with xTaskDelayUntil().
+ *
+ * Returns pdPASS, or errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY.
+ */
+BaseType_t xTaskPeriodicCreate( TaskFunction_t pxTaskCode,
+                                const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                const configSTACK_DEPTH_TYPE usStackDepth,
+                                void * const pvParameters,
+                                UBaseType_t uxPriority,
+                                TickType_t xTaskPeriod,
+                                TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Give the worst case execution time, in ticks, of one job of xTask.  The
+ * LLF policy works the laxity of a job out from it.  A NULL xTask sets the
+ * calling task.
+ */
+void vTaskSetWorstCaseExecutionTime( TaskHandle_t xTask,
+                                     TickType_t xWCET ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the absolute deadline of the current job of xTask, NULL for the
+ * calling task.
+ */
+TickType_t xTaskGetAbsoluteDeadline( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the release time of the current job of xTask, NULL for the calling
+ * task.  A task that restarts at its entry point after an aborted job takes
+ * its last wake time from here.
+ */
+TickType_t xTaskGetReleaseTime( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------
+ * SCHEDULER STATISTICS (configUSE_SCHEDULER_STATS)
+ *----------------------------------------------------------*/
+
+/*
+ * Returns the number of times the scheduler switched to a different task.
+ */
+uint32_t ulTaskGetContextSwitchCount( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the time spent in the tick handler and in the scheduler, in
+ * configBENCHMARK_COUNTER_VALUE() counts.
+ */
+uint32_t ulTaskGetKernelOverheadTime( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of jobs of xTask, NULL for the calling task, that
+ * completed after their deadline.
+ */
+UBaseType_t uxTaskGetDeadlineMissCount( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Clear the context switch count and the kernel overhead time.
+ */
+void vTaskResetSchedulerStats( void ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------
+ * MODE CHANGES (configUSE_MODE_CHANGE)
+ *----------------------------------------------------------*/
+
+/*
+ * Change the period and relative deadline of uxNumberOfTasks tasks at once.
+ * Each task switches at its own next job boundary.  A NULL pxDeadlines, or a
+ * deadline of 0, means a deadline equal to the period.
+ *
+ * Returns pdPASS, or pdFAIL and changes nothing if the density of the task
+ * set in the new mode would be over configMODE_CHANGE_DENSITY_BOUND or, with
+ * configUSE_MIXED_CRITICALITY, if the mixed criticality task set would fail
+ * the EDF-VD test with the new periods.
+ */
+BaseType_t xTaskSetMode( const TaskHandle_t * const pxTasks,
+                         const TickType_t * const pxPeriods,
+                         const TickType_t * const pxDeadlines,
+                         UBaseType_t uxNumberOfTasks ) PRIVILEGED_FUNCTION;
+
+/*
+ * xTaskSetMode() for the single task xTask, NULL for the calling task.
+ */
+BaseType_t xTaskSetPeriod( TaskHandle_t xTask,
+                           TickType_t xNewPeriod,
+                           TickType_t xNewDeadline ) PRIVILEGED_FUNCTION;
+
+/*
+ * End the current job of the calling task as xTaskDelayUntil() does, with
+ * the period the task has once a pending change is applied.
+ */
+BaseType_t xTaskDelayUntilNextPeriod( TickType_t * const pxPreviousWakeTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the density (16.16 fixed point) of the task set once every pending
+ * change is applied.
+ */
+uint32_t ulTaskGetAdmittedLoad( void ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------
+ * ELASTIC TASKS (configUSE_ELASTIC_TASKS)
+ *----------------------------------------------------------*/
+
+/*
+ * Make xTask, NULL for the calling task, elastic: its period can be stretched
+ * from xMinPeriod up to xMaxPeriod, in proportion to uxElasticity, when the
+ * task set is overloaded.
+ *
+ * Returns pdPASS, or pdFAIL if configMAX_ELASTIC_TASKS tasks are already
+ * elastic.
+ */
+BaseType_t xTaskSetElastic( TaskHandle_t xTask,
+                            TickType_t xMinPeriod,
+                            TickType_t xMaxPeriod,
+                            UBaseType_t uxElasticity ) PRIVILEGED_FUNCTION;
+
+/*
+ * Work out the periods of the elastic tasks for ulLoad, the measured or
+ * admitted load (16.16 fixed point) of the whole task set, and request them
+ * through xTaskSetMode().  An elastic task may also have a criticality, its
+ * new period then has to pass the EDF-VD test of xTaskSetMode() and the task
+ * keeps its old period if it does not.
+ *
+ * Returns the result of xTaskSetMode(), pdPASS if no period changes.
+ */
+BaseType_t xTaskElasticAdjust( uint32_t ulLoad ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------
+ * (m,k)-FIRM DEADLINES (configUSE_MK_FIRM)
+ *----------------------------------------------------------*/
+
+/*
+ * Require xTask, NULL for the calling task, to meet at least uxMeet deadlines
+ * in any uxWindow consecutive jobs.  Under overload a released job that can
+ * not meet its deadline is skipped if the constraint allows it.  A uxWindow
+ * of 0 turns the constraint off.
+ *
+ * Returns pdPASS, or pdFAIL if uxWindow is over 32 or uxMeet over uxWindow.
+ */
+BaseType_t xTaskSetMKFirm( TaskHandle_t xTask,
+                           UBaseType_t uxMeet,
+                           UBaseType_t uxWindow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of jobs of xTask, NULL for the calling task, that were
+ * skipped.
+ */
+UBaseType_t uxTaskGetSkippedJobCount( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------
+ * ABORT ON DEADLINE MISS (configUSE_ABORT_ON_MISS)
+ *----------------------------------------------------------*/
+
+/*
+ * With xAbortOnMiss set, a job of xTask, NULL for the calling task, that
+ * passes its deadline is aborted: the task restarts at its entry point at its
+ * next release, unless it holds a mutex.  pxRecoveryHook, if not NULL, is
+ * called with the task handle from the tick interrupt when a job is aborted.
+ *
+ * Returns pdPASS.
+ */
+BaseType_t xTaskSetAbortOnMiss( TaskHandle_t xTask,
+                                BaseType_t xAbortOnMiss,
+                                TaskHookFunction_t pxRecoveryHook ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of jobs of xTask, NULL for the calling task, that were
+ * aborted.
+ */
+UBaseType_t uxTaskGetAbortedJobCount( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------
+ * STACK PROFILING (configUSE_STACK_PROFILING)
+ *----------------------------------------------------------*/
+
+/*
+ * Returns the deepest stack use, in words, the idle task has seen for xTask,
+ * NULL for the calling task, including the use set with
+ * vTaskSetStackUsedMax().
+ */
+configSTACK_DEPTH_TYPE uxTaskGetStackUsedMax( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the deepest stack use of xTask, NULL for the calling task, plus
+ * configSTACK_PROFILING_MARGIN percent, or 0 until its stack has been
+ * sampled.
+ */
+configSTACK_DEPTH_TYPE uxTaskGetRecommendedStackDepth( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Seed the deepest stack use of xTask, NULL for the calling task, with the
+ * value reported by an earlier run.  A lower value than the one seen so far
+ * is ignored.
+ */
+void vTaskSetStackUsedMax( TaskHandle_t xTask,
+                           configSTACK_DEPTH_TYPE uxStackUsedMax ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------
+ * KERNEL BENCHMARK (configUSE_KERNEL_BENCHMARK)
+ *----------------------------------------------------------*/
+
+/*
+ * Write the number of tasks, then one line per kernel path (context switch,
+ * tick, xTaskDelayUntil() and xTaskPeriodicCreate()) with the minimum,
+ * average, maximum and 99th percentile duration, in
+ * configBENCHMARK_COUNTER_VALUE() counts, of the calls since the last
+ * vTaskResetKernelPathStats().  At most uxBufferLength characters, including
+ * the terminating null, are written.  Needs
+ * configUSE_STATS_FORMATTING_FUNCTIONS.
+ */
+void vTaskGetKernelPathStats( char * pcWriteBuffer,
+                              size_t uxBufferLength ) PRIVILEGED_FUNCTION;
+
+/*
+ * Clear the durations measured so far.
+ */
+void vTaskResetKernelPathStats( void ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------
+ * LIMITED PREEMPTION (configUSE_LIMITED_PREEMPTION)
+ *----------------------------------------------------------*/
+
+/*
+ * Start a non-preemptive region of the calling task.  A job that becomes due
+ * meanwhile runs once the region ends, or once the region has lasted the
+ * task's maximum length.  Regions nest.
+ */
+void vTaskEnterNonPreemptiveRegion( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * End a non-preemptive region of the calling task, and give way to a job it
+ * held off.
+ */
+void vTaskExitNonPreemptiveRegion( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Set the longest non-preemptive region, in ticks, of xTask, NULL for the
+ * calling task, and its preemption threshold: a job of xTask is only
+ * preempted by a job whose deadline is earlier by more than
+ * xPreemptionThreshold ticks.
+ */
+void vTaskSetPreemptionLimits( TaskHandle_t xTask,
+                               TickType_t xMaxNPRLength,
+                               TickType_t xPreemptionThreshold ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------
+ * HIGH RESOLUTION RELEASES (configUSE_HIGH_RESOLUTION_RELEASES)
+ *----------------------------------------------------------*/
+
+/*
+ * Release xTask, NULL for the calling task, every ulPeriod counts of
+ * configHR_TIMER_COUNT(), with its deadline ulDeadline counts after each
+ * release.  A ulDeadline of 0 means equal to ulPeriod.  The current job
+ * counts as released now.
+ *
+ * Returns pdPASS, or pdFAIL if configMAX_HR_TASKS tasks already have a high
+ * resolution period.
+ */
+BaseType_t xTaskSetHighResolutionPeriod( TaskHandle_t xTask,
+                                         uint32_t ulPeriod,
+                                         uint32_t ulDeadline ) PRIVILEGED_FUNCTION;
+
+/*
+ * End the current job of the calling task and wait for its next high
+ * resolution release.
+ */
+void vTaskDelayUntilNextRelease( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * To be called from the compare match interrupt of the high resolution
+ * timer.  Returns pdTRUE if a context switch is required.
+ */
+BaseType_t xTaskHighResolutionTimerHandlerFromISR( void ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------
+ * BLOCKING PROFILER (configUSE_BLOCKING_PROFILER)
+ *----------------------------------------------------------*/
+
+/*
+ * Write one line each for the sections with interrupts masked and with the
+ * scheduler suspended, giving their number and their average, maximum and
+ * 99th percentile duration in configBLOCKING_PROFILER_COUNTER_VALUE() counts
+ * since the last vTaskResetBlockingStats(), then the sites with the longest
+ * sections.  At most uxBufferLength characters, including the terminating
+ * null, are written.  Needs configUSE_STATS_FORMATTING_FUNCTIONS.
+ */
+void vTaskGetBlockingStats( char * pcWriteBuffer,
+                            size_t uxBufferLength ) PRIVILEGED_FUNCTION;
+
+/*
+ * Clear the sections measured so far.
+ */
+void vTaskResetBlockingStats( void ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------
+ * SPORADIC TASKS (configUSE_SPORADIC_TASKS)
+ *----------------------------------------------------------*/
+
+/*
+ * Create a task whose jobs are released by xTaskSporadicRelease() or
+ * xTaskSporadicReleaseFromISR(), at least xMinInterArrival ticks apart, each
+ * with its deadline xRelativeDeadline ticks after its release.  A
+ * xRelativeDeadline of 0 means equal to xMinInterArrival.  An arrival less
+ * than xMinInterArrival after the last release is held until then if
+ * xPostponeEarly is pdTRUE, and rejected otherwise.  The task waits for its
+ * first arrival.
+ *
+ * Returns pdPASS, or pdFAIL if configMAX_SPORADIC_TASKS tasks already exist
+ * or the task could not be created.
+ */
+BaseType_t xTaskSporadicCreate( TaskFunction_t pxTaskCode,
+                                const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                const configSTACK_DEPTH_TYPE usStackDepth,
+                                void * const pvParameters,
+                                UBaseType_t uxPriority,
+                                TickType_t xMinInterArrival,
+                                TickType_t xRelativeDeadline,
+                                BaseType_t xPostponeEarly,
+                                TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * End the current job of the calling sporadic task and wait for the next
+ * arrival.
+ */
+void vTaskSporadicWait( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Signal an arrival of the sporadic task xTask.  Only one arrival is held
+ * while a job runs.
+ *
+ * Returns pdPASS, or pdFAIL if the arrival is rejected.
+ */
+BaseType_t xTaskSporadicRelease( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * xTaskSporadicRelease() for interrupts.  *pxHigherPriorityTaskWoken is set
+ * to pdTRUE if a context switch should be requested before the interrupt
+ * exits.
+ */
+BaseType_t xTaskSporadicReleaseFromISR( TaskHandle_t xTask,
+                                        BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of arrivals of xTask, NULL for the calling task, that
+ * were rejected.
+ */
+UBaseType_t uxTaskGetRejectedReleaseCount( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------
+ * MIXED CRITICALITY (configUSE_MIXED_CRITICALITY)
+ *----------------------------------------------------------*/
+
+/*
+ * Make xTask, NULL for the calling task, a HI task if xHighCriticality is
+ * pdTRUE and a LO task otherwise, with a budget of xBudgetLO ticks per job in
+ * LO mode and, for a HI task, xBudgetHI ticks in HI mode.  A HI job that
+ * overruns its LO budget switches the system to HI mode, where LO jobs only
+ * run in the background.  Tasks without a criticality are never put in the
+ * background, so the test counts the ones that exist at the time of the call
+ * as HI tasks with their real deadlines and their worst case execution time.
+ * Later period changes are tested again by xTaskSetMode().
+ *
+ * Returns pdPASS, or pdFAIL and changes nothing if the task set would not be
+ * schedulable under EDF-VD or configMAX_CRITICALITY_TASKS tasks already have
+ * a criticality.
+ */
+BaseType_t xTaskSetCriticality( TaskHandle_t xTask,
+                                BaseType_t xHighCriticality,
+                                TickType_t xBudgetLO,
+                                TickType_t xBudgetHI ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE in HI mode, pdFALSE in LO mode.
+ */
+BaseType_t xTaskGetCriticalityMode( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of switches from LO to HI mode.
+ */
+uint32_t ulTaskGetCriticalitySwitchCount( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of HI jobs that overran their HI budget.
+ */
+uint32_t ulTaskGetBudgetOverrunCount( void ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+	}
+#endif
+/* *INDENT-ON* */
+
+#endif /* INC_EDF_H */
@@ -0,0 +1,101 @@
+/*
+ * FreeRTOS Kernel V10.2.0
+ * Copyright (C) 2019 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Run to completion jobs and deadline timers of the EDF scheduler, implemented
+ * in tasks.c.  Include after task.h.
+ */
+
+#ifndef INC_JOBS_H
+#define INC_JOBS_H
+
+#ifndef INC_TASK_H
+	#error "include FreeRTOS.h and task.h must appear in source files before include jobs.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+	extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/*
+ * Type by which deadline timers are referenced.  For example, a call to
+ * xTaskDeadlineTimerCreate() returns a JobHandle_t variable that can then be
+ * used as a parameter to xTaskDeadlineTimerStart() to start the timer.
+ */
+struct tskJobControlBlock; /* The old naming convention is used to prevent breaking kernel aware debuggers. */
+typedef struct tskJobControlBlock * JobHandle_t;
+
+/*
+ * Create a periodic job with an implicit deadline, released first now and then
+ * every xJobPeriod ticks.  pxJobCode must return without blocking, all the
+ * jobs run one after the other on the stack of one dispatcher task.
+ *
+ * Returns pdPASS, or errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY.
+ */
+BaseType_t xTaskPeriodicJobCreate( TaskFunction_t pxJobCode,
+                                   void * const pvParameters,
+                                   TickType_t xJobPeriod ) PRIVILEGED_FUNCTION;
+
+/*
+ * Create a stopped deadline timer.  Once started, pxCallback is released
+ * xPeriod ticks later, and every xPeriod ticks after that if xAutoReload is
+ * pdTRUE, and runs on the job stack by its deadline xRelativeDeadline ticks
+ * after each release.  A xRelativeDeadline of 0 means equal to xPeriod.
+ *
+ * Returns NULL if there is not enough heap.
+ */
+JobHandle_t xTaskDeadlineTimerCreate( TaskFunction_t pxCallback,
+                                      void * const pvParameters,
+                                      TickType_t xPeriod,
+                                      TickType_t xRelativeDeadline,
+                                      BaseType_t xAutoReload ) PRIVILEGED_FUNCTION;
+
+/*
+ * Start, or restart, xTimer so it is released one period from now.
+ */
+BaseType_t xTaskDeadlineTimerStart( JobHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Stop xTimer.  A callback that is running completes but is not released
+ * again.
+ */
+BaseType_t xTaskDeadlineTimerStop( JobHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE while xTimer is started, pdFALSE once it is stopped or a
+ * one-shot timer has run.
+ */
+BaseType_t xTaskDeadlineTimerIsActive( JobHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+	}
+#endif
+/* *INDENT-ON* */
+
+#endif /* INC_JOBS_H */
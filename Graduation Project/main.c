@@ -55,10 +55,13 @@
 /* Standard includes. */
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 /* Scheduler includes. */
 #include "FreeRTOS.h"
 #include "task.h"
+#include "edf.h"
+#include "jobs.h"
 #include "lpc21xx.h"
 
 /* Peripheral includes. */
@@ -73,6 +76,20 @@
 /* Constants for the ComTest demo application tasks. */
 #define mainCOM_TEST_BAUD_RATE	( ( unsigned long ) 115200 )
 
+/* Timer 1 counts at PCLK / ( mainTIMER1_PRESCALE + 1 ), 1 MHz with the 60 MHz PCLK. */
+#define mainTIMER1_PRESCALE	( ( unsigned long ) 59 )
+
+/* The run time stats count at PCLK / ( mainRUN_TIME_PRESCALE + 1 ), the rate Timer 1 ran at before the high resolution releases. */
+#define mainRUN_TIME_PRESCALE	( ( unsigned long ) 1000 )
+
+/* Timer 1 interrupt on the vectored interrupt controller. */
+#define mainTIMER1_VIC_CHANNEL	( ( unsigned long ) 0x0005 )
+#define mainTIMER1_VIC_ENABLE	( ( unsigned long ) 0x0020 )
+
+/* Button on P0.16 (EINT0), its interrupt on the vectored interrupt controller. */
+#define mainEINT0_VIC_CHANNEL	( ( unsigned long ) 0x000E )
+#define mainEINT0_VIC_ENABLE	( ( unsigned long ) 0x0020 )
+
 
 /*
  * Configure the processor for use with the Keil demo board.  This is very
@@ -84,6 +101,18 @@ static void prvSetupHardware( void );
 void timer1Reset(void);
 static void configTimer1(void);
 
+/* Timer 1 interrupt entry point, saves the task context then calls vTimer1ISRHandler() (timer1ISR.s). */
+extern void vTimer1ISREntry( void );
+void vTimer1ISRHandler( void );
+static void configButtonInterrupt(void);
+
+/* Button interrupt entry point, saves the task context then calls vButtonISRHandler() (buttonISR.s). */
+extern void vButtonISREntry( void );
+void vButtonISRHandler( void );
+
+/* Creates up to Count more benchmark load tasks. */
+void Benchmark_Add_Load_Tasks( int Count );
+
 /* Tick Hook implementation */ 
 void vApplicationTickHook( void )
 {
@@ -97,32 +126,106 @@ void vApplicationTickHook( void )
 
 #define TASK1_TAG			1				/* Task1 Tag. */
 #define TASK1_PERIOD 	60  		/* Task1 Period. */
+#define TASK1_WCET 		16  		/* Task1 worst case execution time (15.1 ms measured for the SimSo model). */
+#define TASK1_WCET_HI 	24  		/* Task1 HI criticality budget, a job that runs past TASK1_WCET switches to HI mode. */
+#define TASK1_ABORT_ON_MISS 	pdFALSE 	/* Task1 abort_on_miss, as in the SimSo model. */
+#define TASK1_STACK_SIZE 	100 		/* Task1 stack size in words. */
+#define TASK1_STACK_USED 	0 			/* Task1 deepest stack use reported by the previous runs (STK line), 0 if unknown. */
 TaskHandle_t Task1_Handle = NULL; /* Task1 Handler. */
 TickType_t Task1_Last_Deadline=0; /* variable to save the last deadline of the task1. */
 TickType_t Task1_End_Time=0;		/* variable to save the end of the execution time for the task1. */
 int Task1_Misses_Counter=0;     /* variable to count the number of  deadline misses for  task1. */
 TickType_t Task1_In_Time=0;    /* variable  to save the In-Time of Task1 */
 TickType_t Task1_Out_Time=0;   /* variable  to save the Out-Time of Task1 */
-TickType_t Task1_Total_Time=0;  /* variable  to save the Total-Time of Task1 */
+unsigned long long Task1_Total_Time=0;  /* variable  to save the Total-Time of Task1 */
 
 
 /* Task2 Variables */ 
 
 #define TASK2_TAG			2					/* Task2 Tag. */
 #define TASK2_PERIOD 	80  			/* Task2 Period. */
+#define TASK2_MAX_PERIOD 	160  	/* The longest period Task2 accepts when it is stretched under overload. */
+#define TASK2_MK_MEET 		3  		/* Task2 must meet at least TASK2_MK_MEET deadlines ... */
+#define TASK2_MK_WINDOW 	4  		/* ... out of any TASK2_MK_WINDOW consecutive jobs. */
+#define TASK2_WCET 		16  			/* Task2 worst case execution time (15.28 ms measured for the SimSo model). */
+#define TASK2_ABORT_ON_MISS 	pdFALSE 	/* Task2 abort_on_miss, as in the SimSo model. */
+#define TASK2_STACK_SIZE 	100 		/* Task2 stack size in words. */
+#define TASK2_MAX_NPR 		20 			/* The longest Task2 may hold off Task1 while it writes to the UART, within Task1's slack (TASK1_PERIOD - TASK1_WCET). */
+#define TASK2_STACK_USED 	0 			/* Task2 deepest stack use reported by the previous runs (STK line), 0 if unknown. */
 TaskHandle_t Task2_Handle = NULL; /* Task2 Handler. */
 TickType_t Task2_Last_Deadline=0;	/* variable to save the last deadline of the task2. */
 TickType_t Task2_End_Time=0;     /* variable to save the end of the execution time for the task2. */
 int Task2_Misses_Counter=0;     /* variable to save the number of  deadline misses for  task2. */
 TickType_t Task2_In_Time=0;    /* variable  to save the In-Time of Task2 */
 TickType_t Task2_Out_Time=0;   /* variable  to save the Out-Time of Task2 */
-TickType_t Task2_Total_Time=0;  /* variable  to save the Total-Time of Task2 */
+unsigned long long Task2_Total_Time=0;  /* variable  to save the Total-Time of Task2 */
+
+
+/* Other Tasks Variables */ 
+
+unsigned int Other_In_Time=0;    /* variable  to save the In-Time of the running task that is not Task1, Task2 or the idle task (Sampler, Button, JOBS, ...). */
+unsigned long long Other_Total_Time=0;  /* variable  to save the Total-Time of those tasks, they count in the CPU load. */
+
+/* Elastic Variables */ 
+
+#define ELASTIC_WINDOW 	240 		/* Hyperperiod of Task1 and Task2 at their nominal periods, the load passed to xTaskElasticAdjust() is measured over it. */
+TickType_t Elastic_Window_Start=0;           /* variable to save the tick the current load window started at. */
+unsigned long long Elastic_Window_Busy=0;    /* variable to save Task1_Total_Time + Task2_Total_Time + Other_Total_Time at the start of the window. */
+unsigned long long Elastic_Window_Total=0;   /* variable to save Total_System_Time at the start of the window. */
+
+/* Heartbeat Job Variables */ 
+
+#define HEARTBEAT_PERIOD 	100 		/* Heartbeat job period, the job runs to completion on the shared job stack. */
+int Heartbeat_State=0;          /* variable to save the current level of the heartbeat pin. */
+
+
+/* Status Timer Variables */ 
+
+#define STATUS_TIMER_PERIOD 	250 		/* Status timer period, the callback runs on the shared job stack. */
+#define STATUS_TIMER_DEADLINE 	5 		/* The callback must complete within this many ticks of each expiry. */
+JobHandle_t Status_Timer_Handle = NULL; /* Status timer Handler. */
+int Status_State=0;             /* variable to save the current level of the status pin. */
+
+
+/* Sampler Task Variables */ 
+
+#define SAMPLER_PERIOD_US 	500 		/* Sampler period in microseconds (T1 counts), released by the timer 1 compare match and not by the tick. */
+#define SAMPLER_STACK_SIZE 	90 			/* Sampler stack size in words. */
+TaskHandle_t Sampler_Handle = NULL; /* Sampler Handler. */
+int Sampler_State=0;            /* variable to save the current level of the sampler pin. */
+
+
+/* Button Task Variables */ 
+
+#define BUTTON_MIN_INTER_ARRIVAL 	10 	/* The button task is released at most once every 10 ticks, closer presses (contact bounce) are rejected. */
+#define BUTTON_DEADLINE 	5 			/* Each press must be handled within 5 ticks. */
+#define BUTTON_STACK_SIZE 	90 			/* Button task stack size in words. */
+TaskHandle_t Button_Handle = NULL; /* Button Handler. */
+int Button_State=0;             /* variable to save the current level of the button pin. */
+
+
+/* Benchmark Variables */ 
+
+#define BENCHMARK_LOAD_TASKS 	0 		/* Number of extra light periodic tasks, to measure the kernel paths at a higher task count. */
+#define BENCHMARK_LOAD_PERIOD 	50 		/* Period of the extra tasks. */
+#define BENCHMARK_LOAD_STACK_SIZE 	90 	/* Stack size in words of the extra tasks. */
+#define BENCHMARK_SWEEP_STEP 	0 		/* Extra tasks added after each kernel path report, so each report is for one task count. 0 creates them all at start. */
+int Benchmark_Load_Count=0;     /* variable to save the number of extra tasks created so far. */
+
+#define RUN_TIME_STATS_LINE 	34 		/* Longest vTaskGetRunTimeStats() line: a 7 character name, two 10 digit numbers, the tabs and "%\r\n". */
+#define RUN_TIME_STATS_TASKS 	(7 + BENCHMARK_LOAD_TASKS) 	/* Task1, Task2, Sampler, Button, JOBS, REL and IDLE, and the extra tasks. */
+
 
 /* Total System Variables */ 
 
-TickType_t Total_System_Time=0;	/*  variable to save the total system time . */
+unsigned long long Total_System_Time=0;	/*  variable to save the total system time . */
+unsigned int Last_Switch_Time=0;	/*  variable to save the T1TC of the last context switch, Total_System_Time counts up to it. */
 float CPU_Load=0; 							/*  variable to save the CPU load. */
-char Run_Time_Stats_Buffer[140]; /*  array to save the system's run time stats . */
+char Run_Time_Stats_Buffer[RUN_TIME_STATS_LINE*RUN_TIME_STATS_TASKS+1]; /*  array to save the system's run time stats . */
+char Scheduler_Stats_Buffer[112]; /*  array to save the scheduler stats (context switches, kernel overhead, misses, rejected presses, HI mode switches and HI budget overruns). */
+char Stack_Profile_Buffer[56];   /*  array to save the deepest stack use and the recommended stack size of each task. */
+char Kernel_Path_Stats_Buffer[256]; /*  array to save the min/avg/max/p99 duration of each kernel path, sized for 10 digit counts. */
+char Blocking_Stats_Buffer[400];    /*  array to save the longest interrupts masked / scheduler suspended sections and where they come from, sized for 10 digit counts. */
 
 
 /* Tasks Implementation */ 
@@ -134,9 +237,9 @@ void Task1( void * Task1_Parameters )
 	int i=0;
 	
 	TickType_t Task1_Last_Wake_Time;										/*  variable to save the last wake time of the task1. */
-	Task1_Last_Wake_Time =xTaskGetTickCount();					/* make the last wake time equal to the current time . */
+	Task1_Last_Wake_Time =xTaskGetReleaseTime(Task1_Handle);					/* make the last wake time equal to the release of the current job, a restarted job keeps the phase. */
 	
-	Task1_Last_Deadline=vTaskGetApplicationTaskItemValue(Task1_Handle);  /* initialize the Task 1 deadline with the current deadline */
+	Task1_Last_Deadline=xTaskGetAbsoluteDeadline(Task1_Handle);  /* initialize the Task 1 deadline with the current deadline */
 
 	for( ;; )
 	{	
@@ -155,10 +258,10 @@ void Task1( void * Task1_Parameters )
 			Task1_Misses_Counter++;
 		}
 		
-		vTaskDelayUntil(&Task1_Last_Wake_Time, TASK1_PERIOD );
+		xTaskDelayUntilNextPeriod(&Task1_Last_Wake_Time);   /* Wait for the next period, a period changed with xTaskSetPeriod() takes effect here. */
 		
 		/* Update the Task1_Last_Deadline variable with the current deadline. */
-		Task1_Last_Deadline=vTaskGetApplicationTaskItemValue(Task1_Handle);
+		Task1_Last_Deadline=xTaskGetAbsoluteDeadline(Task1_Handle);
 	}
 }
 
@@ -171,9 +274,9 @@ void Task2
 	int i=0;
 	
 	TickType_t Task2_Last_Wake_Time;                   /*  variable to save the last wake time of the task2. */
-	Task2_Last_Wake_Time =xTaskGetTickCount();         /* make the last wake time equal to the current time . */
+	Task2_Last_Wake_Time =xTaskGetReleaseTime(Task2_Handle);         /* make the last wake time equal to the release of the current job, a restarted job keeps the phase. */
 	
-	Task2_Last_Deadline=vTaskGetApplicationTaskItemValue(Task2_Handle);  /* initialize the Task 2 deadline with the current deadline */
+	Task2_Last_Deadline=xTaskGetAbsoluteDeadline(Task2_Handle);  /* initialize the Task 2 deadline with the current deadline */
 
 	for( ;; )
 	{	
@@ -182,9 +285,41 @@ void Task2
 			i=i;
 		}
 				
+		vTaskEnterNonPreemptiveRegion();                   /* Keep the UART output of this job in one piece. */
+		
 		vTaskGetRunTimeStats( Run_Time_Stats_Buffer );     /* Save the run time stats of the system on RunTimeStatsBuff array. */
 		xSerialPutChar('\n');                         /* Send a new line character to UART for separating between the new stats. */
-		vSerialPutString(Run_Time_Stats_Buffer,140);       /* Send the new stats to the UART. */
+		vSerialPutString(Run_Time_Stats_Buffer,strlen(Run_Time_Stats_Buffer));       /* Send the new stats to the UART. */
+		
+		/* Send the scheduler stats to the UART to compare the scheduling policies on this task set. */
+		snprintf(Scheduler_Stats_Buffer, sizeof(Scheduler_Stats_Buffer), "CS %u OVH %u M1 %u M2 %u BR %u HI %u OR %u\n",
+						(unsigned int)ulTaskGetContextSwitchCount(), (unsigned int)ulTaskGetKernelOverheadTime(),
+						(unsigned int)uxTaskGetDeadlineMissCount(Task1_Handle), (unsigned int)uxTaskGetDeadlineMissCount(Task2_Handle),
+						(unsigned int)uxTaskGetRejectedReleaseCount(Button_Handle), (unsigned int)ulTaskGetCriticalitySwitchCount(), (unsigned int)ulTaskGetBudgetOverrunCount());
+		vSerialPutString(Scheduler_Stats_Buffer,strlen(Scheduler_Stats_Buffer));
+		
+		/* Send the deepest stack use / recommended stack size of each task, to size TASKx_STACK_SIZE and seed TASKx_STACK_USED. */
+		snprintf(Stack_Profile_Buffer, sizeof(Stack_Profile_Buffer), "STK %u/%u %u/%u\n",
+						(unsigned int)uxTaskGetStackUsedMax(Task1_Handle), (unsigned int)uxTaskGetRecommendedStackDepth(Task1_Handle),
+						(unsigned int)uxTaskGetStackUsedMax(Task2_Handle), (unsigned int)uxTaskGetRecommendedStackDepth(Task2_Handle));
+		vSerialPutString(Stack_Profile_Buffer,strlen(Stack_Profile_Buffer));
+		
+		/* Send the duration of each kernel path (T1 counts) for the current task count. */
+		vTaskGetKernelPathStats( Kernel_Path_Stats_Buffer, sizeof(Kernel_Path_Stats_Buffer) );
+		vSerialPutString(Kernel_Path_Stats_Buffer,strlen(Kernel_Path_Stats_Buffer));
+		
+		if((BENCHMARK_SWEEP_STEP > 0) && (Benchmark_Load_Count < BENCHMARK_LOAD_TASKS))
+		{
+			/* Next step of the task count sweep, the creations are measured with the new task count. */
+			vTaskResetKernelPathStats();
+			Benchmark_Add_Load_Tasks(BENCHMARK_SWEEP_STEP);
+		}
+		
+		/* Send the longest blocking sections (T1 counts) and the sites they were entered from. */
+		vTaskGetBlockingStats( Blocking_Stats_Buffer, sizeof(Blocking_Stats_Buffer) );
+		vSerialPutString(Blocking_Stats_Buffer,strlen(Blocking_Stats_Buffer));
+		
+		vTaskExitNonPreemptiveRegion();                    /* Task1 can preempt again, it runs now if it was released meanwhile. */
 		
 		Task2_End_Time= xTaskGetTickCount();						/* Update the Task2_End_Time variable with the current time. */
 		
@@ -196,10 +331,100 @@ void Task2
 			Task2_Misses_Counter++;
 		}
 		
-		vTaskDelayUntil(&Task2_Last_Wake_Time, TASK2_PERIOD );
+		/* Task2 is a soft task, stretch its period while the CPU load is above the elastic target and restore it when the load drops. */
+		/* The load is that of the last window, CPU_Load counts from boot and hardly moves after a while. */
+		if((TickType_t)(xTaskGetTickCount() - Elastic_Window_Start) >= ELASTIC_WINDOW)
+		{
+			unsigned long long Window_Busy, Window_Total;
+			
+			taskENTER_CRITICAL();                              /* The totals are updated on every context switch. */
+			Window_Busy = (Task1_Total_Time + Task2_Total_Time + Other_Total_Time) - Elastic_Window_Busy;
+			Window_Total = Total_System_Time - Elastic_Window_Total;
+			Elastic_Window_Busy += Window_Busy;
+			Elastic_Window_Total += Window_Total;
+			taskEXIT_CRITICAL();
+			
+			Elastic_Window_Start = xTaskGetTickCount();
+			
+			if(Window_Total > 0)
+			{
+				xTaskElasticAdjust((uint32_t)((Window_Busy << 16) / Window_Total));
+			}
+		}
+		
+		xTaskDelayUntilNextPeriod(&Task2_Last_Wake_Time);   /* Wait for the next period, a period changed with xTaskSetPeriod() takes effect here. */
 		
 		/* Update the Task2_Last_Deadline variable with the current deadline. */
-		Task2_Last_Deadline=vTaskGetApplicationTaskItemValue(Task2_Handle);
+		Task2_Last_Deadline=xTaskGetAbsoluteDeadline(Task2_Handle);
+	}
+}
+
+/* Heartbeat Job Implementation */ 
+
+void Heartbeat_Job( void * Heartbeat_Parameters )
+{
+	/* A run to completion job: it does its work for this period and returns, it must not block. */
+	Heartbeat_State = !Heartbeat_State;
+	GPIO_write(PORT_0,PIN5,(Heartbeat_State ? PIN_IS_HIGH : PIN_IS_LOW));
+}
+
+/* Status Timer Callback Implementation */ 
+
+void Status_Timer_Callback( void * Status_Timer_Parameters )
+{
+	/* A timer callback: it runs to completion at the urgency of its deadline, it must not block. */
+	Status_State = !Status_State;
+	GPIO_write(PORT_0,PIN7,(Status_State ? PIN_IS_HIGH : PIN_IS_LOW));
+}
+
+/* Sampler Task Implementation */ 
+
+void Sampler_Task( void * Sampler_Parameters )
+{
+	for( ;; )
+	{
+		/* Toggles its pin every SAMPLER_PERIOD_US, the edges show the release jitter. */
+		Sampler_State = !Sampler_State;
+		GPIO_write(PORT_0,PIN6,(Sampler_State ? PIN_IS_HIGH : PIN_IS_LOW));
+		
+		vTaskDelayUntilNextRelease();   /* Wait for the next release, a sub-tick period. */
+	}
+}
+
+/* Button Task Implementation */ 
+
+void Button_Task( void * Button_Parameters )
+{
+	for( ;; )
+	{
+		/* One job per accepted press, released by the EINT0 interrupt instead of polling the pin. */
+		Button_State = !Button_State;
+		GPIO_write(PORT_0,PIN8,(Button_State ? PIN_IS_HIGH : PIN_IS_LOW));
+		
+		vTaskSporadicWait();   /* End the job and wait for the next press. */
+	}
+}
+
+/* Benchmark Load Task Implementation */ 
+
+void Benchmark_Load_Task( void * Benchmark_Load_Parameters )
+{
+	TickType_t Load_Last_Wake_Time = xTaskGetTickCount();
+	
+	for( ;; )
+	{
+		/* Only adds tasks to the lists the kernel paths walk, it does no work of its own. */
+		xTaskDelayUntil(&Load_Last_Wake_Time, BENCHMARK_LOAD_PERIOD);
+	}
+}
+
+void Benchmark_Add_Load_Tasks( int Count )
+{
+	while((Count > 0) && (Benchmark_Load_Count < BENCHMARK_LOAD_TASKS))
+	{
+		xTaskPeriodicCreate( Benchmark_Load_Task,  "Load",  BENCHMARK_LOAD_STACK_SIZE, (void *)0, 1, BENCHMARK_LOAD_PERIOD, NULL); /* Creating one extra benchmark task. */
+		Benchmark_Load_Count++;
+		Count--;
 	}
 }
 
@@ -217,12 +442,32 @@ int main( void )
 	
 	/* Create Tasks here */
 	
-	xTaskPeriodicCreate( Task1,  "Task1",  100, (void *)0, 1, TASK1_PERIOD, &Task1_Handle); /* Creating Task1. */
-	xTaskPeriodicCreate( Task2,  "Task2",  100, (void *)0, 2, TASK2_PERIOD, &Task2_Handle); /* Creating Task2. */
+	xTaskPeriodicCreate( Task1,  "Task1",  TASK1_STACK_SIZE, (void *)0, 1, TASK1_PERIOD, &Task1_Handle); /* Creating Task1. */
+	xTaskPeriodicCreate( Task2,  "Task2",  TASK2_STACK_SIZE, (void *)0, 2, TASK2_PERIOD, &Task2_Handle); /* Creating Task2. */
+	xTaskPeriodicJobCreate( Heartbeat_Job, (void *)0, HEARTBEAT_PERIOD); /* Creating the heartbeat job, it needs no stack or TCB of its own. */
+	Status_Timer_Handle = xTaskDeadlineTimerCreate( Status_Timer_Callback, (void *)0, STATUS_TIMER_PERIOD, STATUS_TIMER_DEADLINE, pdTRUE); /* Creating the auto-reload status timer. */
+	xTaskDeadlineTimerStart(Status_Timer_Handle); /* Starting the status timer, it first expires one period from now. */
+	xTaskPeriodicCreate( Sampler_Task,  "Sampler",  SAMPLER_STACK_SIZE, (void *)0, 1, 1, &Sampler_Handle); /* Creating the sampler, its tick period is replaced below. */
+	xTaskSporadicCreate( Button_Task,  "Button",  BUTTON_STACK_SIZE, (void *)0, 1, BUTTON_MIN_INTER_ARRIVAL, BUTTON_DEADLINE, pdFALSE, &Button_Handle); /* Creating the button task, it waits for the first press. */
+	
+	Benchmark_Add_Load_Tasks((BENCHMARK_SWEEP_STEP > 0) ? 0 : BENCHMARK_LOAD_TASKS); /* Creating the extra benchmark tasks, or none if Task2 sweeps the task count. */
 	
 	vTaskSetApplicationTaskTag(Task1_Handle,(void*) TASK1_TAG); /* Setting Task1 Tag. */
 	vTaskSetApplicationTaskTag(Task2_Handle,(void*) TASK2_TAG); /* Setting Task2 Tag. */
 	
+	vTaskSetWorstCaseExecutionTime(Task1_Handle, TASK1_WCET); /* Setting Task1 WCET. */
+	vTaskSetWorstCaseExecutionTime(Task2_Handle, TASK2_WCET); /* Setting Task2 WCET. */
+	xTaskSetElastic(Task2_Handle, TASK2_PERIOD, TASK2_MAX_PERIOD, 1); /* Making Task2 elastic between its nominal and maximum period. */
+	xTaskSetMKFirm(Task2_Handle, TASK2_MK_MEET, TASK2_MK_WINDOW); /* Task2 may skip a job under overload as long as its (m,k) constraint holds. */
+	xTaskSetAbortOnMiss(Task1_Handle, TASK1_ABORT_ON_MISS, NULL); /* Setting Task1 abort-on-miss mode. */
+	xTaskSetAbortOnMiss(Task2_Handle, TASK2_ABORT_ON_MISS, NULL); /* Setting Task2 abort-on-miss mode. */
+	vTaskSetStackUsedMax(Task1_Handle, TASK1_STACK_USED); /* Carrying Task1 stack use over from the previous runs. */
+	vTaskSetStackUsedMax(Task2_Handle, TASK2_STACK_USED); /* Carrying Task2 stack use over from the previous runs. */
+	vTaskSetPreemptionLimits(Task2_Handle, TASK2_MAX_NPR, 0); /* Bounding Task2 non-preemptive regions, no preemption threshold. */
+	xTaskSetHighResolutionPeriod(Sampler_Handle, SAMPLER_PERIOD_US, 0); /* Releasing the sampler from timer 1 every SAMPLER_PERIOD_US, implicit deadline. */
+	xTaskSetCriticality(Task1_Handle, pdTRUE, TASK1_WCET, TASK1_WCET_HI); /* Task1 is HI criticality, it gets a virtual deadline in LO mode. */
+	xTaskSetCriticality(Task2_Handle, pdFALSE, TASK2_WCET, 0); /* Task2 is LO criticality, it only runs in the background in HI mode. Its elastic periods are tested against EDF-VD by xTaskSetMode(). */
+	
 	/* Now all the tasks have been started - start the scheduler.
 	
 	NOTE : Tasks run in system mode and the scheduler runs in Supervisor mode.
@@ -252,6 +497,9 @@ static void prvSetupHardware( void )
 	
 	/* Config trace timer 1 and read T1TC to get current tick */
 	configTimer1();	
+	
+	/* Config the button interrupt that releases the button task */
+	configButtonInterrupt();
 
 	/* Setup the peripheral bus to be the same as the PLL output. */
 	VPBDIV = mainBUS_CLK_FULL;
@@ -259,6 +507,15 @@ static void prvSetupHardware( void )
 
 /*-----------------------------------------------------------*/
 
+/* Run time stats counter, the T1 time since timer 1 started counted in mainRUN_TIME_PRESCALE units.
+ * Total_System_Time only changes in vTaskSwitchContext(), which never runs while the kernel reads this. */
+unsigned int getRunTimeCounter(void)
+{
+	return (unsigned int)(((Total_System_Time + (unsigned int)(T1TC - Last_Switch_Time)) * (mainTIMER1_PRESCALE + 1)) / (mainRUN_TIME_PRESCALE + 1));
+}
+
+/*-----------------------------------------------------------*/
+
 /* Function to reset timer 1 */
 void timer1Reset(void)
 {
@@ -271,6 +528,67 @@ void timer1Reset(void)
 /* Function to initialize and start timer 1 */
 static void configTimer1(void)
 {
-	T1PR = 1000;
+	T1PR = mainTIMER1_PRESCALE;
+	
+	/* The kernel programs MR0 for the next high resolution release, install its interrupt. */
+	VICVectAddr2 = ( unsigned long ) vTimer1ISREntry;
+	VICVectCntl2 = mainTIMER1_VIC_CHANNEL | mainTIMER1_VIC_ENABLE;
+	VICIntEnable |= ( 1UL << mainTIMER1_VIC_CHANNEL );
+	
 	T1TCR |= 0x1;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Timer 1 interrupt handler, called from vTimer1ISREntry once the task context is saved */
+void vTimer1ISRHandler( void )
+{
+	BaseType_t xSwitchRequired;
+	
+	/* Clear the MR0 match interrupt. */
+	T1IR = 0x1;
+	
+	/* Release the tasks that are due, the next match is programmed by the kernel. */
+	xSwitchRequired = xTaskHighResolutionTimerHandlerFromISR();
+	
+	/* If a released task has an earlier deadline switch to it on exit. */
+	portEND_SWITCHING_ISR( xSwitchRequired );
+	
+	/* Clear the VIC interrupt. */
+	VICVectAddr = 0;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Function to route the button on P0.16 to EINT0, falling edge */
+static void configButtonInterrupt(void)
+{
+	PINSEL1 = ( PINSEL1 & ~0x3 ) | 0x1;
+	EXTMODE |= 0x1;
+	EXTPOLAR &= ~0x1;
+	EXTINT = 0x1;
+	
+	VICVectAddr3 = ( unsigned long ) vButtonISREntry;
+	VICVectCntl3 = mainEINT0_VIC_CHANNEL | mainEINT0_VIC_ENABLE;
+	VICIntEnable |= ( 1UL << mainEINT0_VIC_CHANNEL );
+}
+
+/*-----------------------------------------------------------*/
+
+/* Button interrupt handler, called from vButtonISREntry once the task context is saved */
+void vButtonISRHandler( void )
+{
+	BaseType_t xSwitchRequired = pdFALSE;
+	
+	/* Clear the EINT0 edge. */
+	EXTINT = 0x1;
+	
+	/* Release the button task, a press within BUTTON_MIN_INTER_ARRIVAL of the last one is rejected. */
+	( void ) xTaskSporadicReleaseFromISR( Button_Handle, &xSwitchRequired );
+	
+	/* If the button task has an earlier deadline switch to it on exit. */
+	portEND_SWITCHING_ISR( xSwitchRequired );
+	
+	/* Clear the VIC interrupt. */
+	VICVectAddr = 0;
 }
\ No newline at end of file
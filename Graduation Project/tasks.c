@@ -38,6 +38,8 @@
 #include "task.h"
 #include "timers.h"
 #include "stack_macros.h"
+#include "edf.h"
+#include "jobs.h"
 
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
@@ -81,10 +83,125 @@
 #define tskSTATICALLY_ALLOCATED_STACK_ONLY        ( ( uint8_t ) 1 )
 #define tskSTATICALLY_ALLOCATED_STACK_AND_TCB     ( ( uint8_t ) 2 )
 
+/* Stack profiling samples the high water mark of every task from the idle task
+ * and recommends a stack depth for each of them. */
+#ifndef configUSE_STACK_PROFILING
+    #define configUSE_STACK_PROFILING    0
+#endif
+
+#if ( configUSE_STACK_PROFILING == 1 )
+
+/* Minimum number of ticks between two samples taken by the idle task. */
+    #ifndef configSTACK_PROFILING_PERIOD
+        #define configSTACK_PROFILING_PERIOD    ( ( TickType_t ) 1000U )
+    #endif
+
+/* Head room, as a percentage of the deepest stack use seen, that is added to
+ * the recommended stack depth. */
+    #ifndef configSTACK_PROFILING_MARGIN
+        #define configSTACK_PROFILING_MARGIN    ( 25U )
+    #endif
+
+#endif
+
+/* The kernel benchmark measures how long vTaskSwitchContext(), the tick
+ * handler, xTaskDelayUntil() and xTaskPeriodicCreate() take. */
+#ifndef configUSE_KERNEL_BENCHMARK
+    #define configUSE_KERNEL_BENCHMARK    0
+#endif
+
+/* The time base of the benchmark and of the kernel overhead statistic.
+ * Defaults to the run time stats counter, a cycle counter gives a finer
+ * resolution where the port has one. */
+#ifndef configBENCHMARK_COUNTER_VALUE
+    #define configBENCHMARK_COUNTER_VALUE()    portGET_RUN_TIME_COUNTER_VALUE()
+#endif
+
+#if ( configUSE_KERNEL_BENCHMARK == 1 )
+
+/* The 99th percentile is read from a histogram of configBENCHMARK_BUCKETS
+ * buckets, each configBENCHMARK_BUCKET_WIDTH counts wide. */
+    #ifndef configBENCHMARK_BUCKETS
+        #define configBENCHMARK_BUCKETS    ( 32 )
+    #endif
+
+    #ifndef configBENCHMARK_BUCKET_WIDTH
+        #define configBENCHMARK_BUCKET_WIDTH    ( 1 )
+    #endif
+
+/* The kernel paths that are measured. */
+    #define tskBENCH_SWITCH_CONTEXT     ( 0 )
+    #define tskBENCH_INCREMENT_TICK     ( 1 )
+    #define tskBENCH_DELAY_UNTIL        ( 2 )
+    #define tskBENCH_PERIODIC_CREATE    ( 3 )
+    #define tskBENCH_NUMBER_OF_PATHS    ( 4 )
+
+#endif
+
+/* The blocking profiler measures how long interrupts stay masked by the
+ * critical sections of this file and by the tick handler, and how long the
+ * scheduler stays suspended, with the place each section was entered from. */
+#ifndef configUSE_BLOCKING_PROFILER
+    #define configUSE_BLOCKING_PROFILER    0
+#endif
+
+#if ( configUSE_BLOCKING_PROFILER == 1 )
+
+/* The time base of the profiler, as for the kernel benchmark. */
+    #ifndef configBLOCKING_PROFILER_COUNTER_VALUE
+        #define configBLOCKING_PROFILER_COUNTER_VALUE()    portGET_RUN_TIME_COUNTER_VALUE()
+    #endif
+
+/* Durations are counted in power of 2 buckets, bucket n holding those from
+ * 2^(n-1) to 2^n - 1 counts.  The last bucket holds everything longer. */
+    #ifndef configBLOCKING_PROFILER_BUCKETS
+        #define configBLOCKING_PROFILER_BUCKETS    ( 16 )
+    #endif
+
+/* The number of places whose longest section is remembered for each kind. */
+    #ifndef configBLOCKING_PROFILER_SITES
+        #define configBLOCKING_PROFILER_SITES    ( 4 )
+    #endif
+
+/* Returns the address vTaskSuspendAll() was called from, the place a
+ * scheduler suspended section is attributed to.  Critical sections are
+ * attributed to their line in this file instead. */
+    #ifndef configBLOCKING_PROFILER_CALLER
+        #if defined( __GNUC__ )
+            #define configBLOCKING_PROFILER_CALLER()    ( ( uint32_t ) ( portPOINTER_SIZE_TYPE ) __builtin_return_address( 0 ) )
+        #else
+            #define configBLOCKING_PROFILER_CALLER()    ( 0UL )
+        #endif
+    #endif
+
+/* The kinds of blocking that are measured. */
+    #define tskBLOCK_INTERRUPTS_MASKED        ( 0 )
+    #define tskBLOCK_SCHEDULER_SUSPENDED      ( 1 )
+    #define tskBLOCK_NUMBER_OF_KINDS          ( 2 )
+
+/* The site the tick handler is attributed to, no line of this file is 0. */
+    #define tskBLOCK_SITE_TICK                ( 0UL )
+
+/* Time the critical sections of this file, the port keeps the real nesting. */
+    #undef taskENTER_CRITICAL
+    #undef taskEXIT_CRITICAL
+    #define taskENTER_CRITICAL()                                     \
+    do {                                                             \
+        portENTER_CRITICAL();                                        \
+        prvBlockingCriticalEnter( ( uint32_t ) __LINE__ );           \
+    } while( 0 )
+    #define taskEXIT_CRITICAL()                                      \
+    do {                                                             \
+        prvBlockingCriticalExit();                                   \
+        portEXIT_CRITICAL();                                         \
+    } while( 0 )
+
+#endif
+
 /* If any of the following are set then task stacks are filled with a known
  * value so the high water mark can be determined.  If none of the following are
  * set then don't fill the stack so there is no unnecessary dependency on memset. */
-#if ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+#if ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) || ( configUSE_STACK_PROFILING == 1 ) )
     #define tskSET_NEW_STACKS_TO_KNOWN_VALUE    1
 #else
     #define tskSET_NEW_STACKS_TO_KNOWN_VALUE    0
@@ -235,11 +352,414 @@
 					TickType_t ItemValue = listGET_LIST_ITEM_VALUE(&( ( pxTCB )->xStateListItem ));																									\
 					listSET_LIST_ITEM_VALUE( &( ( xIdleTaskHandle )->xStateListItem ),( TickType_t )(ItemValue+1));																	\
 				}                                                                                                  																\
-				vListInsert( &(xReadyTasksListEDF), &( ( pxTCB )->xStateListItem ) );																															\
+				taskREADY_SET_INSERT( pxTCB );																																										\
 				tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+		/* Scheduling policies that can be selected with configSCHEDULING_POLICY.
+		 * All of them share the same ready list (xReadyTasksListEDF), they only differ
+		 * in the key each job is sorted by when it is released. */
+		#define tskPOLICY_RM        0 /* Rate monotonic: shortest period first. */
+		#define tskPOLICY_DM        1 /* Deadline monotonic: shortest relative deadline first. */
+		#define tskPOLICY_EDF       2 /* Earliest absolute deadline first. */
+		#define tskPOLICY_LLF       3 /* Least laxity (deadline - remaining execution) first. */
+		#define tskPOLICY_CUSTOM    4 /* Key supplied by configPOLICY_KEY( pxTCB ) in FreeRTOSConfig.h. */
+
+		#ifndef configSCHEDULING_POLICY
+				#define configSCHEDULING_POLICY    tskPOLICY_EDF
+		#endif
+
+		#ifndef configUSE_SCHEDULER_STATS
+				#define configUSE_SCHEDULER_STATS    0
+		#endif
+
+		#ifndef configUSE_MODE_CHANGE
+				#define configUSE_MODE_CHANGE    0
+		#endif
+
+		#if ( configUSE_MODE_CHANGE == 1 )
+
+				/* Densities (WCET / min( deadline, period )) are kept in 16.16 fixed point. */
+				#define tskDENSITY_SHIFT    16U
+				#define tskDENSITY_ONE      ( ( uint32_t ) 1UL << tskDENSITY_SHIFT )
+
+				/* The total density the mode change protocol lets the tasks commit, 1.0
+				 * is the EDF bound.  Set it lower for RM/DM or to keep some slack. */
+				#ifndef configMODE_CHANGE_DENSITY_BOUND
+						#define configMODE_CHANGE_DENSITY_BOUND    tskDENSITY_ONE
+				#endif
+
+		#endif /* configUSE_MODE_CHANGE */
+
+		#ifndef configUSE_ELASTIC_TASKS
+				#define configUSE_ELASTIC_TASKS    0
+		#endif
+
+		#if ( configUSE_ELASTIC_TASKS == 1 )
+
+				#if ( configUSE_MODE_CHANGE != 1 )
+						#error configUSE_MODE_CHANGE must be set to 1 to use elastic tasks as their periods are changed through xTaskSetMode()
+				#endif
+
+				/* The number of tasks that can be registered with xTaskSetElastic(). */
+				#ifndef configMAX_ELASTIC_TASKS
+						#define configMAX_ELASTIC_TASKS    ( 4 )
+				#endif
+
+				/* The load (16.16 fixed point) xTaskElasticAdjust() compresses the task
+				 * set down to. */
+				#ifndef configELASTIC_TARGET_LOAD
+						#define configELASTIC_TARGET_LOAD    ( ( tskDENSITY_ONE * 9UL ) / 10UL )
+				#endif
+
+		#endif /* configUSE_ELASTIC_TASKS */
+
+		#ifndef configUSE_MK_FIRM
+				#define configUSE_MK_FIRM    0
+		#endif
+
+		#ifndef configUSE_ABORT_ON_MISS
+				#define configUSE_ABORT_ON_MISS    0
+		#endif
+
+		#if ( ( configUSE_ABORT_ON_MISS == 1 ) && ( portUSING_MPU_WRAPPERS == 1 ) )
+				#error configUSE_ABORT_ON_MISS is not supported by MPU ports
+		#endif
+
+		#ifndef configUSE_RUN_TO_COMPLETION_JOBS
+				#define configUSE_RUN_TO_COMPLETION_JOBS    0
+		#endif
+
+		#ifndef configUSE_LIMITED_PREEMPTION
+				#define configUSE_LIMITED_PREEMPTION    0
+		#endif
+
+		#ifndef configUSE_HIGH_RESOLUTION_RELEASES
+				#define configUSE_HIGH_RESOLUTION_RELEASES    0
+		#endif
+
+		#if ( configUSE_HIGH_RESOLUTION_RELEASES == 1 )
+
+				/* The port supplies a free running counter with a compare interrupt,
+				 * see FreeRTOSConfig.h. */
+				#if !defined( configHR_TIMER_COUNT ) || !defined( configHR_TIMER_SET_COMPARE ) || !defined( configHR_TIMER_STOP_COMPARE ) || !defined( configHR_COUNTS_PER_TICK )
+						#error configUSE_HIGH_RESOLUTION_RELEASES requires configHR_TIMER_COUNT(), configHR_TIMER_SET_COMPARE(), configHR_TIMER_STOP_COMPARE() and configHR_COUNTS_PER_TICK
+				#endif
+
+				/* The number of tasks that can be given a period with xTaskSetHighResolutionPeriod(). */
+				#ifndef configMAX_HR_TASKS
+						#define configMAX_HR_TASKS    ( 4 )
+				#endif
+
+				/* Timer counts rounded up to ticks. */
+				#define tskHR_COUNTS_TO_TICKS( ulCounts )    ( ( TickType_t ) ( ( ( ulCounts ) + ( configHR_COUNTS_PER_TICK - 1UL ) ) / configHR_COUNTS_PER_TICK ) )
+
+				/* The tick a release that is ulLateness timer counts late was due in. */
+				#define tskHR_RELEASE_TICK( ulLateness )    ( ( TickType_t ) ( xTickCount - ( TickType_t ) ( ( ulLateness ) / configHR_COUNTS_PER_TICK ) ) )
+
+		#endif /* configUSE_HIGH_RESOLUTION_RELEASES */
+
+		#if ( configUSE_RUN_TO_COMPLETION_JOBS == 1 )
+
+				#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+						#error configUSE_RUN_TO_COMPLETION_JOBS requires configSUPPORT_DYNAMIC_ALLOCATION
+				#endif
+
+				/* The stack shared by all the run to completion jobs, in words.  It
+				 * must hold the deepest job. */
+				#ifndef configJOB_DISPATCHER_STACK_SIZE
+						#define configJOB_DISPATCHER_STACK_SIZE    ( configMINIMAL_STACK_SIZE * 2U )
+				#endif
+
+				#ifndef configJOB_DISPATCHER_NAME
+						#define configJOB_DISPATCHER_NAME    "JOBS"
+				#endif
+
+		#endif /* configUSE_RUN_TO_COMPLETION_JOBS */
+
+		#ifndef configUSE_DEADLINE_TIMERS
+				#define configUSE_DEADLINE_TIMERS    0
+		#endif
+
+		/* With deferred releases the tick only queues the tasks it unblocks, the
+		 * release task gives them their deadline and sorts them into the ready
+		 * list, so the time spent in the tick interrupt does not grow with the
+		 * number of ready tasks. */
+		#ifndef configUSE_DEFERRED_RELEASES
+				#define configUSE_DEFERRED_RELEASES    0
+		#endif
+
+		#if ( configUSE_DEFERRED_RELEASES == 1 )
+
+				#ifndef configRELEASE_TASK_STACK_SIZE
+						#define configRELEASE_TASK_STACK_SIZE    configMINIMAL_STACK_SIZE
+				#endif
+
+				#ifndef configRELEASE_TASK_NAME
+						#define configRELEASE_TASK_NAME    "REL"
+				#endif
+
+		#endif /* configUSE_DEFERRED_RELEASES */
+
+		/* Sporadic tasks are released by an event rather than by a period, at
+		 * most once every minimum inter-arrival time.  A task waits for its next
+		 * release in xSuspendedTaskList. */
+		#ifndef configUSE_SPORADIC_TASKS
+				#define configUSE_SPORADIC_TASKS    0
+		#endif
+
+		#if ( configUSE_SPORADIC_TASKS == 1 )
+
+				#if ( INCLUDE_vTaskSuspend != 1 )
+						#error configUSE_SPORADIC_TASKS requires INCLUDE_vTaskSuspend
+				#endif
+
+				/* The number of tasks that can be created with xTaskSporadicCreate(). */
+				#ifndef configMAX_SPORADIC_TASKS
+						#define configMAX_SPORADIC_TASKS    ( 4 )
+				#endif
+
+				/* pdTRUE if tick xA comes before tick xB, allowing for the tick count
+				 * wrapping between the two. */
+				#define tskTICK_BEFORE( xA, xB )    ( ( ( TickType_t ) ( ( xA ) - ( xB ) ) > ( portMAX_DELAY >> 1 ) ) ? pdTRUE : pdFALSE )
+
+		#endif /* configUSE_SPORADIC_TASKS */
+
+		/* Mixed criticality (EDF-VD).  A LO task has one execution budget, a HI
+		 * task has a LO and a larger HI budget.  In LO mode HI jobs are sorted by
+		 * a virtual deadline, earlier than their real one, so they keep enough
+		 * slack to run for their HI budget.  A HI job that runs past its LO budget
+		 * switches the system to HI mode, in which HI jobs are sorted by their real
+		 * deadline and LO jobs only run when no HI job is ready.  The system goes
+		 * back to LO mode at the next idle instant.  A HI job that runs past its HI
+		 * budget is counted and the rest of it runs in the background, like a LO
+		 * job past its LO budget. */
+		#ifndef configUSE_MIXED_CRITICALITY
+				#define configUSE_MIXED_CRITICALITY    0
+		#endif
+
+		#if ( configUSE_MIXED_CRITICALITY == 1 )
+
+				#if ( configSCHEDULING_POLICY != tskPOLICY_EDF )
+						#error configUSE_MIXED_CRITICALITY requires configSCHEDULING_POLICY to be tskPOLICY_EDF
+				#endif
+
+				/* The number of tasks that can be given a criticality with xTaskSetCriticality(). */
+				#ifndef configMAX_CRITICALITY_TASKS
+						#define configMAX_CRITICALITY_TASKS    ( 8 )
+				#endif
+
+				/* Set to 1 to have vApplicationBudgetOverrunHook() called, from the
+				 * tick interrupt, each time a HI job overruns its HI budget. */
+				#ifndef configUSE_BUDGET_OVERRUN_HOOK
+						#define configUSE_BUDGET_OVERRUN_HOOK    0
+				#endif
+
+				#define tskCRITICALITY_NONE    ( ( uint8_t ) 0U ) /* Not part of the mixed criticality task set, always sorted by its deadline. */
+				#define tskCRITICALITY_LO      ( ( uint8_t ) 1U )
+				#define tskCRITICALITY_HI      ( ( uint8_t ) 2U )
+
+				/* Utilisations and the virtual deadline factor are kept in 16.16
+				 * fixed point. */
+				#define tskCRITICALITY_SHIFT    16U
+				#define tskCRITICALITY_ONE      ( ( uint32_t ) 1UL << tskCRITICALITY_SHIFT )
+				#define tskCRITICALITY_UTILISATION( xBudget, xPeriod )    ( ( ( uint32_t ) ( xBudget ) << tskCRITICALITY_SHIFT ) / ( uint32_t ) ( xPeriod ) )
+
+				/* Returned by prvCriticalityTest() in place of the factor, which is
+				 * never above tskCRITICALITY_ONE. */
+				#define tskCRITICALITY_NOT_SCHEDULABLE    ( ( uint32_t ) 0xffffffffUL )
+
+				/* The key of a LO job that may only run in the background.  It is
+				 * after every deadline and before the idle task, which is moved to
+				 * portMAX_DELAY by prvAddTaskToReadyList(). */
+				#define tskCRITICALITY_BACKGROUND_KEY    ( portMAX_DELAY - ( TickType_t ) 1U )
+
+		#endif /* configUSE_MIXED_CRITICALITY */
+
+		/* With EDF buckets the ready jobs whose key is within a window of
+		 * tskEDF_BUCKETS buckets are kept in a calendar of per bucket lists, found
+		 * through a two level bitmap.  Inserting a job and finding the earliest one
+		 * no longer walk the whole ready set.  Keys outside the window, and the idle
+		 * task, are kept in the sorted xReadyTasksListEDF as before. */
+		#ifndef configUSE_EDF_BUCKETS
+				#define configUSE_EDF_BUCKETS    0
+		#endif
+
+		#if ( configUSE_EDF_BUCKETS == 1 )
+
+				/* Groups of 32 buckets, a power of 2 no greater than 32. */
+				#ifndef configEDF_BUCKET_GROUPS
+						#define configEDF_BUCKET_GROUPS    ( 4 )
+				#endif
+
+				/* A bucket holds the keys that are the same once shifted right by
+				 * configEDF_BUCKET_SHIFT, so the window is ( 32 * groups ) << shift
+				 * ticks for the deadline based policies. */
+				#ifndef configEDF_BUCKET_SHIFT
+						#define configEDF_BUCKET_SHIFT    ( 1 )
+				#endif
+
+				/* Number of leading zero bits in a non zero 32 bit value. */
+				#ifndef configEDF_CLZ
+						#if defined( __GNUC__ )
+								#define configEDF_CLZ( ulBits )    ( ( UBaseType_t ) __builtin_clz( ulBits ) )
+						#else
+								#define configEDF_CLZ( ulBits )    prvCountLeadingZeros( ulBits )
+						#endif
+				#endif
+
+				#if ( ( configEDF_BUCKET_GROUPS > 32 ) || ( ( configEDF_BUCKET_GROUPS & ( configEDF_BUCKET_GROUPS - 1 ) ) != 0 ) )
+						#error configEDF_BUCKET_GROUPS must be a power of 2 no greater than 32
+				#endif
+
+				#define tskEDF_BUCKETS    ( ( UBaseType_t ) configEDF_BUCKET_GROUPS * ( UBaseType_t ) 32U )
+
+				/* The bucket lists and the sorted list, for the code that visits every
+				 * ready task.  List 0 is xReadyTasksListEDF. */
+				#define tskEDF_READY_LISTS    ( tskEDF_BUCKETS + ( UBaseType_t ) 1U )
+				#define taskEDF_READY_LIST( uxList )    ( ( ( uxList ) == ( UBaseType_t ) 0U ) ? &xReadyTasksListEDF : &( xReadyBucketsEDF[ ( uxList ) - ( UBaseType_t ) 1U ] ) )
+
+				#define taskREADY_SET_INSERT( pxTCB )    prvReadySetInsert( pxTCB )
+				#define taskREADY_SET_HEAD()             prvReadySetHead()
+
+				/* pdTRUE if the task is in the ready set, in a bucket or in the sorted list. */
+				#define taskIS_READY_EDF( pxTCB )                                                                                  \
+						( ( ( listIS_CONTAINED_WITHIN( &xReadyTasksListEDF, &( ( pxTCB )->xStateListItem ) ) != pdFALSE ) ||          \
+								( ( listLIST_ITEM_CONTAINER( &( ( pxTCB )->xStateListItem ) ) >= &( xReadyBucketsEDF[ 0 ] ) ) &&            \
+									( listLIST_ITEM_CONTAINER( &( ( pxTCB )->xStateListItem ) ) <= &( xReadyBucketsEDF[ tskEDF_BUCKETS - 1U ] ) ) ) ) ? pdTRUE : pdFALSE )
+		#endif /* configUSE_EDF_BUCKETS */
+
+		/* With the EDF array the first configEDF_ARRAY_SLOTS tasks created each get
+		 * a slot in an array of keys.  Making one of them ready stores its key and
+		 * sets its bit in a mask, the earliest is found with a branchless scan of
+		 * the array.  That is quicker than walking a list for a handful of tasks.
+		 * Other tasks, and the idle task, are kept in the sorted xReadyTasksListEDF
+		 * as before. */
+		#ifndef configUSE_EDF_ARRAY
+				#define configUSE_EDF_ARRAY    0
+		#endif
+
+		#if ( configUSE_EDF_ARRAY == 1 )
+
+				/* At most 32, one bit each in the ready mask. */
+				#ifndef configEDF_ARRAY_SLOTS
+						#define configEDF_ARRAY_SLOTS    ( 16 )
+				#endif
+
+				#if ( configEDF_ARRAY_SLOTS > 32 )
+						#error configEDF_ARRAY_SLOTS must be no greater than 32
+				#endif
+
+				#if ( configUSE_EDF_BUCKETS == 1 )
+						#error configUSE_EDF_ARRAY and configUSE_EDF_BUCKETS can not both be set
+				#endif
+
+				/* The slot of a task that does not have one. */
+				#define tskNO_READY_SLOT    ( ( UBaseType_t ) configEDF_ARRAY_SLOTS )
+
+				/* xReadyArrayListEDF holds the ready tasks that have a slot, in no
+				 * order, so they can be removed and tested like any other ready task. */
+				#define tskEDF_READY_LISTS    ( ( UBaseType_t ) 2U )
+				#define taskEDF_READY_LIST( uxList )    ( ( ( uxList ) == ( UBaseType_t ) 0U ) ? &xReadyTasksListEDF : &xReadyArrayListEDF )
+
+				#define taskREADY_SET_INSERT( pxTCB )    prvReadySetInsert( pxTCB )
+				#define taskREADY_SET_HEAD()             prvReadySetHead()
+
+				#define taskIS_READY_EDF( pxTCB )                                                                         \
+						( ( ( listIS_CONTAINED_WITHIN( &xReadyTasksListEDF, &( ( pxTCB )->xStateListItem ) ) != pdFALSE ) ||  \
+								( listIS_CONTAINED_WITHIN( &xReadyArrayListEDF, &( ( pxTCB )->xStateListItem ) ) != pdFALSE ) ) ? pdTRUE : pdFALSE )
+
+		#endif /* configUSE_EDF_ARRAY */
+
+		#if ( ( configUSE_EDF_BUCKETS == 0 ) && ( configUSE_EDF_ARRAY == 0 ) )
+				#define tskEDF_READY_LISTS                 ( ( UBaseType_t ) 1U )
+				#define taskEDF_READY_LIST( uxList )       ( &xReadyTasksListEDF )
+				#define taskREADY_SET_INSERT( pxTCB )      vListInsert( &( xReadyTasksListEDF ), &( ( pxTCB )->xStateListItem ) )
+				#define taskREADY_SET_HEAD()               ( ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( xReadyTasksListEDF ) ) )
+				#define taskIS_READY_EDF( pxTCB )          listIS_CONTAINED_WITHIN( &xReadyTasksListEDF, &( ( pxTCB )->xStateListItem ) )
+		#endif
+
+		#if ( ( configUSE_DEADLINE_TIMERS == 1 ) && ( configUSE_RUN_TO_COMPLETION_JOBS != 1 ) )
+				#error configUSE_RUN_TO_COMPLETION_JOBS must be set to 1 to use deadline timers as their callbacks are run by the job dispatcher
+		#endif
+
+		/*
+		 * Key hook: the value a released job is sorted by in xReadyTasksListEDF,
+		 * lower values run first.
+		 */
+		#if ( configSCHEDULING_POLICY == tskPOLICY_RM )
+				#define taskPOLICY_KEY( pxTCB )    ( ( pxTCB )->xTaskPeriod )
+		#elif ( configSCHEDULING_POLICY == tskPOLICY_DM )
+				#define taskPOLICY_KEY( pxTCB )    ( ( pxTCB )->xTaskRelativeDeadline )
+		#elif ( ( configSCHEDULING_POLICY == tskPOLICY_EDF ) && ( configUSE_MIXED_CRITICALITY == 1 ) )
+				#define taskPOLICY_KEY( pxTCB )    prvCriticalityKey( pxTCB )
+		#elif ( configSCHEDULING_POLICY == tskPOLICY_EDF )
+				#define taskPOLICY_KEY( pxTCB )    ( ( pxTCB )->xTaskAbsoluteDeadline )
+		#elif ( configSCHEDULING_POLICY == tskPOLICY_LLF )
+				#define taskPOLICY_KEY( pxTCB )    ( ( pxTCB )->xTaskAbsoluteDeadline - ( pxTCB )->xTaskRemainingExecution )
+		#elif ( configSCHEDULING_POLICY == tskPOLICY_CUSTOM )
+				#define taskPOLICY_KEY( pxTCB )    configPOLICY_KEY( pxTCB )
+		#else
+				#error configSCHEDULING_POLICY must be set to one of the tskPOLICY_ values
+		#endif
+
+		/*
+		 * Release hook: start a new job of the task represented by pxTCB that was
+		 * released at xReleaseTime.  Its absolute deadline and sort key are updated,
+		 * the task still has to be placed in the ready list with prvAddTaskToReadyList().
+		 */
+		#define taskPOLICY_RELEASE( pxTCB, xReleaseTime )                                                      \
+		{                                                                                                      \
+				( pxTCB )->xTaskAbsoluteDeadline = ( TickType_t ) ( ( xReleaseTime ) + ( pxTCB )->xTaskRelativeDeadline ); \
+				( pxTCB )->xTaskRemainingExecution = ( pxTCB )->xTaskWCET;                                         \
+				taskMC_JOB_RELEASED( pxTCB );                                                                      \
+				listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), ( TickType_t ) taskPOLICY_KEY( pxTCB ) );   \
+				taskMK_JOB_RELEASED( pxTCB );                                                                      \
+				taskABORT_JOB_RELEASED( pxTCB );                                                                   \
+		} /* taskPOLICY_RELEASE */
+
+		#if ( configUSE_MK_FIRM == 1 )
+				#define taskMK_JOB_RELEASED( pxTCB )    ( ( pxTCB )->ucJobStarted = pdFALSE )
+		#else
+				#define taskMK_JOB_RELEASED( pxTCB )
+		#endif
+
+		#if ( configUSE_MIXED_CRITICALITY == 1 )
+				#define taskMC_JOB_RELEASED( pxTCB )    ( ( pxTCB )->xJobExecution = ( TickType_t ) 0U )
+		#else
+				#define taskMC_JOB_RELEASED( pxTCB )
+		#endif
+
+		#if ( configUSE_ABORT_ON_MISS == 1 )
+				#define taskABORT_JOB_RELEASED( pxTCB )    ( ( pxTCB )->ucMissLatched = pdFALSE )
+		#else
+				#define taskABORT_JOB_RELEASED( pxTCB )
+		#endif
+
+		/*
+		 * Preempt-check hook: pdTRUE if the ready task represented by pxTCB should
+		 * run instead of the currently running task.  With limited preemption the
+		 * running task can hold the switch off, see prvLimitedPreemptionCheck().
+		 */
+		#if ( configUSE_LIMITED_PREEMPTION == 1 )
+				#define taskPOLICY_SHOULD_PREEMPT( pxTCB )    prvLimitedPreemptionCheck( pxTCB )
+		#else
+				#define taskPOLICY_SHOULD_PREEMPT( pxTCB ) \
+						( ( listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) ) < listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ) ) ) ? pdTRUE : pdFALSE )
+		#endif
+
+		/*
+		 * Select hook: the ready list is kept sorted by the policy key so the task to
+		 * run is always the one at the head of the list.
+		 */
+		#define taskPOLICY_SELECT()    pxCurrentTCB = taskREADY_SET_HEAD()
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
 /*
  * Several functions take an TaskHandle_t parameter that can optionally be NULL,
  * where NULL is used to indicate that the handle of the currently executing
@@ -281,6 +801,74 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
 		
 		#if ( configUSE_EDF_SCHEDULER == 1 )
 				TickType_t xTaskPeriod; /* Adding a new member on the task TCB which holding the task's period. */  
+				TickType_t xTaskRelativeDeadline;   /*< The deadline of each job relative to its release, equal to xTaskPeriod unless changed. */
+				TickType_t xTaskAbsoluteDeadline;   /*< The absolute deadline of the current job. */
+				TickType_t xTaskWCET;               /*< Worst case execution time of one job in ticks, used by the LLF policy (0 if unknown). */
+				TickType_t xTaskRemainingExecution; /*< Execution ticks the current job is still expected to need. */
+				#if ( configUSE_SCHEDULER_STATS == 1 )
+						UBaseType_t uxDeadlineMisses;   /*< Number of jobs of this task that completed after their absolute deadline. */
+				#endif
+				#if ( configUSE_MODE_CHANGE == 1 )
+						TickType_t xTaskPendingPeriod;   /*< Period requested by xTaskSetPeriod(), applied at the next job boundary. */
+						TickType_t xTaskPendingDeadline; /*< Relative deadline requested by xTaskSetPeriod(), applied with the period. */
+						uint8_t ucPeriodChangePending;   /*< Set to pdTRUE while a requested change has not been applied yet. */
+						uint32_t ulTaskDensity;          /*< The density of the task that is counted in ulCommittedDensity. */
+				#endif
+				#if ( configUSE_ELASTIC_TASKS == 1 )
+						TickType_t xTaskMinPeriod;       /*< The nominal period of an elastic task, used when there is no overload. */
+						TickType_t xTaskMaxPeriod;       /*< The longest period an elastic task accepts. */
+						UBaseType_t uxElasticity;        /*< Elastic coefficient, the larger it is the more the period is stretched. 0 if not elastic. */
+				#endif
+				#if ( configUSE_MK_FIRM == 1 )
+						UBaseType_t uxMKMeet;            /*< At least uxMKMeet jobs out of any uxMKWindow consecutive jobs must meet their deadline. */
+						UBaseType_t uxMKWindow;          /*< The k of the (m,k) constraint, 0 if the task has no (m,k) constraint (at most 32). */
+						uint32_t ulMKHistory;            /*< Outcome of the last uxMKWindow jobs, bit 0 is the most recent, a set bit is a met deadline. */
+						uint8_t ucMKWaiting;             /*< pdTRUE while the task waits in xTaskDelayUntil() for the release of its current job, only such a job can be skipped. */
+						uint8_t ucMKSkipped;             /*< pdTRUE once the release the task waits for was skipped, xTaskDelayUntil() then returns xMKSkippedWakeTime. */
+						TickType_t xMKSkippedWakeTime;   /*< The release the task was moved on to by the last skip. */
+						uint8_t ucJobStarted;            /*< pdFALSE from the release of a job until the job is first switched in. */
+						UBaseType_t uxSkippedJobs;       /*< Number of jobs skipped to keep the other tasks within their (m,k) constraint. */
+				#endif
+				#if ( configUSE_ABORT_ON_MISS == 1 )
+						TaskFunction_t pxTaskCode;        /*< The job entry point, a task whose job is aborted restarts here. */
+						void * pvParameters;              /*< Passed to pxTaskCode when the task restarts. */
+						StackType_t * pxInitialTopOfStack; /*< Top of stack before the initial context was built, used to build it again. */
+						uint8_t ucAbortOnMiss;            /*< pdTRUE if a job of this task is aborted when it misses its deadline. */
+						TaskHookFunction_t pxRecoveryHook; /*< Called with the task handle when a job is aborted, NULL if not used. */
+						UBaseType_t uxAbortedJobs;        /*< Number of jobs of this task that were aborted. */
+						uint8_t ucMissLatched;            /*< pdTRUE once the current job missed its deadline but could not be aborted, it then runs to completion. */
+				#endif
+				#if ( configUSE_LIMITED_PREEMPTION == 1 )
+						UBaseType_t uxNPRNesting;         /*< Non 0 while the task is in a non-preemptive region. */
+						TickType_t xNPRStartTime;         /*< The time the outermost non-preemptive region was entered. */
+						TickType_t xMaxNPRLength;         /*< The longest a non-preemptive region can hold off a preemption, portMAX_DELAY if not bounded. */
+						TickType_t xPreemptionThreshold;  /*< A job only preempts this task if its key is lower by more than this. */
+				#endif
+				#if ( configUSE_HIGH_RESOLUTION_RELEASES == 1 )
+						uint32_t ulHRPeriod;              /*< Period in timer counts, 0 if the task is released by the tick. */
+						uint32_t ulHRDeadline;            /*< Relative deadline in timer counts. */
+						uint32_t ulHRRelease;             /*< Timer count the current job was (or the next job will be) released at. */
+						uint8_t ucHRWaiting;              /*< pdTRUE while the task waits in vTaskDelayUntilNextRelease() for ulHRRelease. */
+				#endif
+				#if ( configUSE_EDF_ARRAY == 1 )
+						UBaseType_t uxReadySlot;          /*< Index of the task in xReadyKeysEDF, tskNO_READY_SLOT if it is kept in xReadyTasksListEDF. */
+				#endif
+				#if ( configUSE_SPORADIC_TASKS == 1 )
+						TickType_t xMinInterArrival;      /*< The shortest time between two releases, 0 if the task is not sporadic. */
+						TickType_t xSporadicLastRelease;  /*< Release time of the last job. */
+						TickType_t xSporadicNextRelease;  /*< Release time of the held arrival, valid while ucSporadicPending is pdTRUE. */
+						uint8_t ucSporadicWaiting;        /*< pdTRUE while the task waits in vTaskSporadicWait() for an arrival. */
+						uint8_t ucSporadicPending;        /*< pdTRUE if an arrival is held until the current job ends or until it is due. */
+						uint8_t ucPostponeEarly;          /*< pdTRUE if an early arrival is postponed, pdFALSE if it is rejected. */
+						UBaseType_t uxRejectedReleases;   /*< Number of arrivals that were rejected. */
+				#endif
+				#if ( configUSE_MIXED_CRITICALITY == 1 )
+						uint8_t ucCriticality;            /*< tskCRITICALITY_LO or tskCRITICALITY_HI, tskCRITICALITY_NONE until set with xTaskSetCriticality(). */
+						TickType_t xBudgetLO;             /*< Execution budget of a job in LO mode. */
+						TickType_t xBudgetHI;             /*< Execution budget of a job of a HI task in HI mode. */
+						TickType_t xVirtualDeadline;      /*< Relative deadline a HI job is sorted by in LO mode. */
+						TickType_t xJobExecution;         /*< Ticks the current job has run for. */
+				#endif
 		#endif //
 	
     StackType_t * pxStack;                      /*< Points to the start of the stack. */
@@ -290,6 +878,16 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         StackType_t * pxEndOfStack; /*< Points to the highest valid address for the stack. */
     #endif
 
+    #if ( configUSE_STACK_PROFILING == 1 )
+        configSTACK_DEPTH_TYPE uxStackDepth;   /*< The size of the stack in words. */
+        configSTACK_DEPTH_TYPE uxStackUsedMax; /*< The deepest stack use seen in words, including the use reported from earlier runs. */
+    #endif
+
+    #if ( configUSE_BLOCKING_PROFILER == 1 )
+        UBaseType_t uxBlockingDepth; /*< Critical section nesting of the task while it is switched out, a task can yield from a critical section. */
+        uint32_t ulBlockingSite;     /*< Line the outermost of those critical sections was entered from. */
+    #endif
+
     #if ( portCRITICAL_NESTING_IN_TCB == 1 )
         UBaseType_t uxCriticalNesting; /*< Holds the critical section nesting depth for ports that do not maintain their own count in the port layer. */
     #endif
@@ -373,6 +971,110 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tas
 
 #if ( configUSE_EDF_SCHEDULER == 1 )
 		PRIVILEGED_DATA static List_t xReadyTasksListEDF; /*< List for saving the ready tasks depending on earliest deadline. */
+
+		#if ( configUSE_EDF_BUCKETS == 1 )
+				PRIVILEGED_DATA static List_t xReadyBucketsEDF[ tskEDF_BUCKETS ];             /*< The ready jobs whose key is in the window, bucket n holds the keys k with ( k >> configEDF_BUCKET_SHIFT ) % tskEDF_BUCKETS == n. */
+				PRIVILEGED_DATA static uint32_t ulBucketMapEDF[ configEDF_BUCKET_GROUPS ];     /*< A set bit for each bucket that may hold jobs, the most significant bit is the first bucket of the group. */
+				PRIVILEGED_DATA static uint32_t ulBucketGroupMapEDF = 0UL;                     /*< A set bit for each group with a bit set in ulBucketMapEDF. */
+				PRIVILEGED_DATA static TickType_t xBucketBaseEDF = ( TickType_t ) 0U;          /*< Shifted key of the first bucket of the window, no job in a bucket is earlier. */
+				PRIVILEGED_DATA static TickType_t xBucketLastEDF = ( TickType_t ) 0U;          /*< Shifted key of the latest job put in a bucket since the buckets were last empty. */
+				PRIVILEGED_DATA static BaseType_t xBucketsEmptyEDF = pdTRUE;                   /*< pdTRUE when the window can be moved anywhere. */
+		#endif
+
+		#if ( configUSE_EDF_ARRAY == 1 )
+				PRIVILEGED_DATA static List_t xReadyArrayListEDF;                             /*< The ready tasks that have a slot, in no particular order. */
+				PRIVILEGED_DATA static TickType_t xReadyKeysEDF[ configEDF_ARRAY_SLOTS ];     /*< Key of the task in each slot, portMAX_DELAY once it is known not to be ready. */
+				PRIVILEGED_DATA static TCB_t * pxReadySlotsEDF[ configEDF_ARRAY_SLOTS ];      /*< The task given each slot, NULL if the slot is free. */
+				PRIVILEGED_DATA static uint32_t ulReadyMaskEDF = 0UL;                         /*< Bit n is set while xReadyKeysEDF[ n ] holds the key of a ready task. */
+				PRIVILEGED_DATA static UBaseType_t uxReadySlotsUsedEDF = ( UBaseType_t ) 0U;  /*< Slots from here on have never been given, they are not scanned. */
+		#endif
+
+		#if ( configUSE_RUN_TO_COMPLETION_JOBS == 1 )
+
+				/*
+				 * Job control block.  A periodic job or a deadline timer that runs
+				 * to completion is a callback rather than a task, all the jobs run on
+				 * the stack of the dispatcher task.
+				 *
+				 * The dispatcher is a task so the jobs are scheduled by their own
+				 * deadlines against the other tasks.  The tick interrupt or the idle
+				 * task would run them ahead of, or behind, everything else, and the
+				 * timer service task is scheduled by priority.  One dispatcher stack
+				 * replaces a task stack and TCB per job, it pays for itself from the
+				 * second job on.
+				 */
+				typedef struct tskJobControlBlock
+				{
+						ListItem_t xJobListItem;         /*< In xJobsWaitingList by release time, or in xJobsReadyList by deadline.  In no list while it runs or is stopped. */
+						TaskFunction_t pxJobCode;        /*< Called once per release, must return without blocking. */
+						void * pvParameters;             /*< Passed to pxJobCode. */
+						TickType_t xJobPeriod;           /*< Period of the job, or the time from starting a timer to its first release. */
+						TickType_t xJobRelativeDeadline; /*< Deadline of each job relative to its release, equal to xJobPeriod for periodic jobs. */
+						TickType_t xJobReleaseTime;      /*< The release time of the current or next job. */
+						TickType_t xJobAbsoluteDeadline; /*< The deadline of the current job. */
+						uint8_t ucJobAutoReload;         /*< pdTRUE if the job is released again one period after each release. */
+						uint8_t ucJobActive;             /*< pdFALSE once a timer is stopped or a one-shot timer has run. */
+				} JCB_t;
+
+				PRIVILEGED_DATA static List_t xJobsWaitingList;                    /*< Jobs waiting for their next release. */
+				PRIVILEGED_DATA static List_t xJobsReadyList;                      /*< Released jobs in deadline order. */
+				PRIVILEGED_DATA static TaskHandle_t xJobDispatcherHandle = NULL;   /*< The task that runs the jobs. */
+
+		#endif /* configUSE_RUN_TO_COMPLETION_JOBS */
+
+		#if ( configUSE_HIGH_RESOLUTION_RELEASES == 1 )
+				PRIVILEGED_DATA static TCB_t * pxHRTasks[ configMAX_HR_TASKS ];             /*< Tasks registered with xTaskSetHighResolutionPeriod(). */
+				PRIVILEGED_DATA static UBaseType_t uxHRTasks = ( UBaseType_t ) 0U;           /*< Number of valid entries in pxHRTasks. */
+				PRIVILEGED_DATA static volatile BaseType_t xHRReleasePending = pdFALSE;      /*< Set when the compare interrupt found the scheduler suspended. */
+		#endif
+
+		#if ( configUSE_DEFERRED_RELEASES == 1 )
+				PRIVILEGED_DATA static List_t xPendingReleaseList;             /*< Tasks unblocked by the tick, in release order, the item value is the release time. */
+				PRIVILEGED_DATA static TaskHandle_t xReleaseTaskHandle = NULL; /*< The task that moves them to the ready list. */
+		#endif
+
+		#if ( configUSE_SPORADIC_TASKS == 1 )
+				PRIVILEGED_DATA static TCB_t * pxSporadicTasks[ configMAX_SPORADIC_TASKS ]; /*< Tasks created with xTaskSporadicCreate(). */
+				PRIVILEGED_DATA static UBaseType_t uxSporadicTasks = ( UBaseType_t ) 0U;     /*< Number of valid entries in pxSporadicTasks. */
+		#endif
+
+		#if ( configUSE_MIXED_CRITICALITY == 1 )
+				PRIVILEGED_DATA static TCB_t * pxCriticalityTasks[ configMAX_CRITICALITY_TASKS ]; /*< Tasks given a criticality with xTaskSetCriticality(). */
+				PRIVILEGED_DATA static UBaseType_t uxCriticalityTasks = ( UBaseType_t ) 0U;         /*< Number of valid entries in pxCriticalityTasks. */
+				PRIVILEGED_DATA static volatile BaseType_t xCriticalityHigh = pdFALSE;              /*< pdTRUE in HI mode. */
+				PRIVILEGED_DATA static volatile uint32_t ulCriticalitySwitchCount = 0UL;            /*< Number of switches to HI mode. */
+				PRIVILEGED_DATA static volatile uint32_t ulBudgetOverrunCount = 0UL;                /*< Number of HI jobs that ran past their HI budget. */
+				PRIVILEGED_DATA static uint32_t ulCriticalityFactor = 0UL;                          /*< Virtual deadline factor of the task set, 16.16 fixed point. */
+
+				/* A mode change asked for with xTaskSetMode(), that the mixed
+				 * criticality task set is tested with before it is accepted. */
+				typedef struct tskCriticalityChange
+				{
+						const TaskHandle_t * pxTasks;   /*< Tasks whose period changes. */
+						const TickType_t * pxPeriods;   /*< Their new periods. */
+						const TickType_t * pxDeadlines; /*< Their new deadlines, NULL or 0 for implicit deadlines. */
+						UBaseType_t uxNumberOfTasks;    /*< Number of entries in the arrays. */
+				} CriticalityChange_t;
+		#endif
+
+		#if ( configUSE_LIMITED_PREEMPTION == 1 )
+				PRIVILEGED_DATA static volatile BaseType_t xPreemptionDeferred = pdFALSE; /*< Set when a preemption of the running task was held off by a non-preemptive region. */
+		#endif
+
+		#if ( configUSE_SCHEDULER_STATS == 1 )
+				PRIVILEGED_DATA static volatile uint32_t ulContextSwitchCount = 0UL;  /*< Number of times vTaskSwitchContext() selected a different task. */
+				PRIVILEGED_DATA static volatile uint32_t ulKernelOverheadTime = 0UL;  /*< configBENCHMARK_COUNTER_VALUE() counts spent inside the tick handler and vTaskSwitchContext(). */
+		#endif
+
+		#if ( configUSE_MODE_CHANGE == 1 )
+				PRIVILEGED_DATA static uint32_t ulCommittedDensity = 0UL; /*< Sum of the densities the tasks run with now, the higher of the old and new one for a task in transition. */
+				PRIVILEGED_DATA static uint32_t ulTargetDensity = 0UL;    /*< Sum of the densities the tasks will run with once every pending change is applied. */
+		#endif
+
+		#if ( configUSE_ELASTIC_TASKS == 1 )
+				PRIVILEGED_DATA static TCB_t * pxElasticTasks[ configMAX_ELASTIC_TASKS ]; /*< Tasks registered with xTaskSetElastic(). */
+				PRIVILEGED_DATA static UBaseType_t uxElasticTasks = ( UBaseType_t ) 0U;   /*< Number of valid entries in pxElasticTasks. */
+		#endif
 #endif //
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -421,6 +1123,55 @@ const volatile UBaseType_t uxTopUsedPriority = configMAX_PRIORITIES - 1U;
  * accessed from a critical section. */
 PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t ) pdFALSE;
 
+#if ( configUSE_KERNEL_BENCHMARK == 1 )
+
+/* The durations measured for one kernel path. */
+    typedef struct tskBenchmarkPath
+    {
+        uint32_t ulMin;                                  /*< Shortest duration. */
+        uint32_t ulMax;                                  /*< Longest duration. */
+        uint32_t ulTotal;                                /*< Sum of the durations, for the average. */
+        uint32_t ulCount;                                /*< Number of calls measured. */
+        uint32_t ulBuckets[ configBENCHMARK_BUCKETS ];   /*< Histogram of the durations. */
+    } BenchmarkPath_t;
+
+    PRIVILEGED_DATA static BenchmarkPath_t xBenchmarkPaths[ tskBENCH_NUMBER_OF_PATHS ] = { { 0xffffffffUL, 0UL, 0UL, 0UL, { 0UL } },
+                                                                                          { 0xffffffffUL, 0UL, 0UL, 0UL, { 0UL } },
+                                                                                          { 0xffffffffUL, 0UL, 0UL, 0UL, { 0UL } },
+                                                                                          { 0xffffffffUL, 0UL, 0UL, 0UL, { 0UL } } };
+
+#endif
+
+#if ( configUSE_BLOCKING_PROFILER == 1 )
+
+/* The longest section entered from one place. */
+    typedef struct tskBlockingSite
+    {
+        uint32_t ulSite;  /*< Line or caller address, see configBLOCKING_PROFILER_CALLER(). */
+        uint32_t ulMax;   /*< Longest section entered from ulSite. */
+        uint32_t ulCount; /*< Number of sections entered from ulSite, 0 if the entry is free. */
+    } BlockingSite_t;
+
+/* The durations measured for one kind of blocking. */
+    typedef struct tskBlockingKind
+    {
+        uint32_t ulMax;                                           /*< Longest duration. */
+        uint32_t ulTotal;                                         /*< Sum of the durations, for the average. */
+        uint32_t ulCount;                                         /*< Number of sections measured. */
+        uint32_t ulBuckets[ configBLOCKING_PROFILER_BUCKETS ];    /*< Histogram of the durations. */
+        BlockingSite_t xSites[ configBLOCKING_PROFILER_SITES ];   /*< The places with the longest sections. */
+    } BlockingKind_t;
+
+    PRIVILEGED_DATA static BlockingKind_t xBlockingKinds[ tskBLOCK_NUMBER_OF_KINDS ];
+    PRIVILEGED_DATA static UBaseType_t uxBlockingCriticalDepth = ( UBaseType_t ) 0U; /*< Critical section nesting of the running task. */
+    PRIVILEGED_DATA static uint32_t ulBlockingCriticalStart = 0UL;                   /*< Time the outermost critical section was entered, or the task switched back in. */
+    PRIVILEGED_DATA static uint32_t ulBlockingCriticalSite = 0UL;                    /*< Line the outermost critical section was entered from. */
+    PRIVILEGED_DATA static uint32_t ulBlockingSuspendStart = 0UL;                    /*< Time the scheduler was suspended. */
+    PRIVILEGED_DATA static uint32_t ulBlockingSuspendSite = 0UL;                     /*< Where the scheduler was suspended from. */
+    PRIVILEGED_DATA static BaseType_t xBlockingReplayingTicks = pdFALSE;             /*< pdTRUE while xTaskResumeAll() processes pended ticks, which are not the tick handler. */
+
+#endif
+
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
 /* Do not move these variables to function scope as doing so prevents the
@@ -467,67 +1218,260 @@ static void prvInitialiseTaskLists( void ) PRIVILEGED_FUNCTION;
 static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
 
 /*
- * Utility to free all memory allocated by the scheduler to hold a TCB,
- * including the stack pointed to by the TCB.
- *
- * This does not free memory allocated by the task itself (i.e. memory
- * allocated by calls to pvPortMalloc from within the tasks application code).
+ * The task that runs the run to completion jobs created by
+ * xTaskPeriodicJobCreate().  It is created with the first job, its stack is
+ * shared by all the jobs.
  */
-#if ( INCLUDE_vTaskDelete == 1 )
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_RUN_TO_COMPLETION_JOBS == 1 ) )
 
-    static void prvDeleteTCB( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    static portTASK_FUNCTION_PROTO( prvJobDispatcherTask, pvParameters ) PRIVILEGED_FUNCTION;
 
 #endif
 
 /*
- * Used only by the idle task.  This checks to see if anything has been placed
- * in the list of tasks waiting to be deleted.  If so the task is cleaned up
- * and its TCB deleted.
+ * Allocate a job, creating the dispatcher task first if this is the first job.
+ * The job is not released, returns NULL if there is not enough heap.
  */
-static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_RUN_TO_COMPLETION_JOBS == 1 ) )
 
-/*
- * The currently executing task is entering the Blocked state.  Add the task to
- * either the current or the overflow delayed task list.
- */
-static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
-                                            const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION;
+    static JCB_t * prvJobCreate( TaskFunction_t pxJobCode,
+                                 void * const pvParameters,
+                                 TickType_t xJobPeriod,
+                                 TickType_t xJobRelativeDeadline,
+                                 BaseType_t xAutoReload ) PRIVILEGED_FUNCTION;
+
+#endif
 
 /*
- * Fills an TaskStatus_t structure with information on each task that is
- * referenced from the pxList list (which may be a ready list, a delayed list,
- * a suspended list, etc.).
- *
- * THIS FUNCTION IS INTENDED FOR DEBUGGING ONLY, AND SHOULD NOT BE CALLED FROM
- * NORMAL APPLICATION CODE.
+ * Used with deadline timers.  Make the dispatcher ready if it is blocked, so it
+ * sees a timer that was started for a release earlier than the one it waits
+ * for.  Must be called from a critical section, returns pdTRUE if the caller
+ * should yield once it has left the critical section.
  */
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_DEADLINE_TIMERS == 1 ) )
 
-    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
-                                                     List_t * pxList,
-                                                     eTaskState eState ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvJobDispatcherWake( void ) PRIVILEGED_FUNCTION;
 
 #endif
 
 /*
- * Searches pxList for a task with name pcNameToQuery - returning a handle to
- * the task if it is found, or NULL if the task is not found.
+ * Used with deferred releases.  The release task releases the tasks queued in
+ * xPendingReleaseList one at a time, each in its own critical section, then
+ * leaves the ready list until prvReleaseTaskWake() is called for the next
+ * release.  prvReleaseTaskWake() must be called with interrupts masked, it
+ * returns pdTRUE if the release task should preempt the running task.
  */
-#if ( INCLUDE_xTaskGetHandle == 1 )
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_DEFERRED_RELEASES == 1 ) )
 
-    static TCB_t * prvSearchForNameWithinSingleList( List_t * pxList,
-                                                     const char pcNameToQuery[] ) PRIVILEGED_FUNCTION;
+    static portTASK_FUNCTION_PROTO( prvReleaseTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+    static BaseType_t prvReleaseTaskWake( void ) PRIVILEGED_FUNCTION;
 
 #endif
 
 /*
- * When a task is created, the stack of the task is filled with a known value.
- * This function determines the 'high water mark' of the task stack by
- * determining how much of the stack remains at the original preset value.
+ * Used with sporadic tasks.  prvSporadicArrival() accepts, holds or rejects an
+ * arrival for pxTCB and returns pdFAIL if it was rejected.  prvSporadicRelease()
+ * moves a waiting task to the ready list, or to xPendingReadyList if the
+ * scheduler is suspended.  prvSporadicTick() releases the held arrivals of
+ * waiting tasks once they are due.  All must be called with interrupts masked,
+ * *pxSwitchRequired is set to pdTRUE if a released task should preempt the
+ * running task.
  */
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_SPORADIC_TASKS == 1 ) )
 
-    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvSporadicArrival( TCB_t * pxTCB,
+                                          BaseType_t * pxSwitchRequired ) PRIVILEGED_FUNCTION;
+
+    static void prvSporadicRelease( TCB_t * pxTCB,
+                                    TickType_t xReleaseTime,
+                                    BaseType_t * pxSwitchRequired ) PRIVILEGED_FUNCTION;
+
+    static void prvSporadicTick( BaseType_t * pxSwitchRequired ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Used with mixed criticality.  prvCriticalityKey() is the EDF key of pxTCB in
+ * the current mode.  prvCriticalityTick() charges the tick to the running job
+ * and switches mode when a budget is overrun or at an idle instant.
+ * prvCriticalitySwitch() changes mode and re-sorts the ready tasks of the mixed
+ * criticality task set.  Those two must be called from the tick handler.
+ * prvCriticalityTest() is the EDF-VD test of the task set with pxTCB, if not
+ * NULL, given the criticality and budgets passed in, and with the periods of
+ * pxChange, if not NULL.  It returns the virtual deadline factor, or
+ * tskCRITICALITY_NOT_SCHEDULABLE.  prvCriticalityWindow() gets the period and
+ * deadline pxTCB is tested with.  prvCriticalityNoneLoad() adds up the density
+ * of the tasks in pxList that have no criticality, other than the idle task and
+ * pxExcludedTCB.  prvCriticalityVirtualDeadline() scales the relative deadline
+ * of pxTCB by ulCriticalityFactor.
+ */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_MIXED_CRITICALITY == 1 ) )
+
+    static TickType_t prvCriticalityKey( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+    static void prvCriticalityTick( BaseType_t * pxSwitchRequired ) PRIVILEGED_FUNCTION;
+
+    static void prvCriticalitySwitch( BaseType_t xHigh ) PRIVILEGED_FUNCTION;
+
+    static uint32_t prvCriticalityTest( const TCB_t * pxTCB,
+                                        BaseType_t xHighCriticality,
+                                        TickType_t xBudgetLO,
+                                        TickType_t xBudgetHI,
+                                        const CriticalityChange_t * pxChange ) PRIVILEGED_FUNCTION;
+
+    static void prvCriticalityWindow( const TCB_t * pxTCB,
+                                      const CriticalityChange_t * pxChange,
+                                      TickType_t * pxPeriod,
+                                      TickType_t * pxDeadline ) PRIVILEGED_FUNCTION;
+
+    static uint32_t prvCriticalityNoneLoad( const List_t * pxList,
+                                            const TCB_t * pxExcludedTCB,
+                                            const CriticalityChange_t * pxChange ) PRIVILEGED_FUNCTION;
+
+    static void prvCriticalityVirtualDeadline( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Used with EDF buckets or the EDF array.  prvReadySetInsert() places the task in the bucket of
+ * its key, or in xReadyTasksListEDF if the key is outside the window.
+ * prvReadySetHead() returns the ready task with the lowest key and moves the
+ * window up to it.  Bits left set by tasks removed from a bucket are cleared by
+ * prvReadySetHead() when it comes across them.  Both must be called with
+ * interrupts masked or the scheduler suspended.
+ */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( ( configUSE_EDF_BUCKETS == 1 ) || ( configUSE_EDF_ARRAY == 1 ) ) )
+
+    static void prvReadySetInsert( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+    static TCB_t * prvReadySetHead( void ) PRIVILEGED_FUNCTION;
+
+    #if ( ( configUSE_EDF_BUCKETS == 1 ) && !defined( __GNUC__ ) )
+        static UBaseType_t prvCountLeadingZeros( uint32_t ulBits ) PRIVILEGED_FUNCTION;
+    #endif
+
+#endif
+
+/*
+ * Utility to free all memory allocated by the scheduler to hold a TCB,
+ * including the stack pointed to by the TCB.
+ *
+ * This does not free memory allocated by the task itself (i.e. memory
+ * allocated by calls to pvPortMalloc from within the tasks application code).
+ */
+#if ( INCLUDE_vTaskDelete == 1 )
+
+    static void prvDeleteTCB( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Used only by the idle task.  This checks to see if anything has been placed
+ * in the list of tasks waiting to be deleted.  If so the task is cleaned up
+ * and its TCB deleted.
+ */
+static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * The currently executing task is entering the Blocked state.  Add the task to
+ * either the current or the overflow delayed task list.
+ */
+static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
+                                            const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION;
+
+/*
+ * Fills an TaskStatus_t structure with information on each task that is
+ * referenced from the pxList list (which may be a ready list, a delayed list,
+ * a suspended list, etc.).
+ *
+ * THIS FUNCTION IS INTENDED FOR DEBUGGING ONLY, AND SHOULD NOT BE CALLED FROM
+ * NORMAL APPLICATION CODE.
+ */
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
+                                                     List_t * pxList,
+                                                     eTaskState eState ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Searches pxList for a task with name pcNameToQuery - returning a handle to
+ * the task if it is found, or NULL if the task is not found.
+ */
+#if ( INCLUDE_xTaskGetHandle == 1 )
+
+    static TCB_t * prvSearchForNameWithinSingleList( List_t * pxList,
+                                                     const char pcNameToQuery[] ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * When a task is created, the stack of the task is filled with a known value.
+ * This function determines the 'high water mark' of the task stack by
+ * determining how much of the stack remains at the original preset value.
+ */
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) || ( configUSE_STACK_PROFILING == 1 ) )
+
+    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Adds the time since ulStartTime, read with configBENCHMARK_COUNTER_VALUE(), to
+ * the durations measured for the kernel path uxPath.  Must be called with that
+ * path protected from being re-entered.
+ */
+#if ( configUSE_KERNEL_BENCHMARK == 1 )
+
+    static void prvBenchmarkRecord( UBaseType_t uxPath,
+                                    uint32_t ulStartTime ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Adds the time since ulStartTime, read with
+ * configBLOCKING_PROFILER_COUNTER_VALUE(), to the durations measured for the
+ * kind of blocking uxKind, attributed to ulSite.  Must be called with
+ * interrupts masked.  The enter and exit functions are called by
+ * taskENTER_CRITICAL() and taskEXIT_CRITICAL() with interrupts masked, only
+ * the outermost section of a nest is measured.
+ */
+#if ( configUSE_BLOCKING_PROFILER == 1 )
+
+    static void prvBlockingRecord( UBaseType_t uxKind,
+                                   uint32_t ulStartTime,
+                                   uint32_t ulSite ) PRIVILEGED_FUNCTION;
+
+    static void prvBlockingCriticalEnter( uint32_t ulSite ) PRIVILEGED_FUNCTION;
+
+    static void prvBlockingCriticalExit( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Used by vTaskGetKernelPathStats() and vTaskGetBlockingStats().  The number of
+ * characters snprintf() wrote to a buffer of uxBufferLength characters, not
+ * counting the terminating null, given the value it returned.
+ */
+#if ( ( ( configUSE_KERNEL_BENCHMARK == 1 ) || ( configUSE_BLOCKING_PROFILER == 1 ) ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+
+    static size_t prvSnprintfReturnValueToCharsWritten( int iSnprintfReturnValue,
+                                                        size_t uxBufferLength ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called from the idle task.  At most once every configSTACK_PROFILING_PERIOD
+ * ticks, update the deepest stack use of every task from the high water mark
+ * of its stack.  prvStackProfileList() does so for the tasks in one list.
+ */
+#if ( configUSE_STACK_PROFILING == 1 )
+
+    static void prvSampleTaskStacks( void ) PRIVILEGED_FUNCTION;
+
+    static void prvStackProfileList( const List_t * pxList ) PRIVILEGED_FUNCTION;
 
 #endif
 
@@ -599,6 +1543,93 @@ static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
  */
 static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
+/*
+ * Used with the mode change protocol.  Computes the density of a task with the
+ * given parameters, and applies the period/deadline change that was requested
+ * for pxTCB if it can be applied at this job boundary without overloading the
+ * system.  Must be called from a critical section.
+ */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_MODE_CHANGE == 1 ) )
+
+		static uint32_t prvTaskDensity( TickType_t xWCET,
+																		TickType_t xPeriod,
+																		TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+
+		static uint32_t prvTaskTargetDensity( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+		static void prvApplyPendingPeriodChange( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Used with (m,k)-firm tasks.  prvMKRecordOutcome() shifts the outcome of the
+ * job that just ended (or was skipped) into the task's history,
+ * prvMKDistanceToFailure() returns how many more jobs in a row the task can lose
+ * before its (m,k) constraint is violated (0 means the next job is mandatory),
+ * and prvMKShedLoad() skips one optional job if the job of pxReleasedTCB can not
+ * meet its deadline.  Must be called from a critical section.
+ */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_MK_FIRM == 1 ) )
+
+		static void prvMKRecordOutcome( TCB_t * pxTCB,
+																		BaseType_t xDeadlineMet ) PRIVILEGED_FUNCTION;
+
+		static UBaseType_t prvMKDistanceToFailure( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+		static void prvMKShedLoad( const TCB_t * pxReleasedTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Used with limited preemption.  pdTRUE if the ready task pxTCB should preempt
+ * the running task, taking the preemption threshold and the non-preemptive
+ * region of the running task into account.  A preemption held off by the
+ * region is recorded in xPreemptionDeferred.
+ */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_LIMITED_PREEMPTION == 1 ) )
+
+		static BaseType_t prvLimitedPreemptionCheck( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Place the ready task pxTCB in the delayed list until xReleaseTime, which must
+ * be after the current tick count, without releasing a job.  Used when a job is
+ * skipped or aborted.  Must be called from a critical section.
+ */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( ( configUSE_MK_FIRM == 1 ) || ( configUSE_ABORT_ON_MISS == 1 ) ) )
+
+		static void prvDelayTaskUntilRelease( TCB_t * pxTCB,
+																					TickType_t xReleaseTime ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Used with abort-on-miss tasks.  If the job of the ready task pxTCB has passed
+ * its deadline, call the recovery hook of the task, reset the task to its job
+ * entry point and hold it until its next release.  Returns pdTRUE if the job was
+ * aborted.  Must only be called from vTaskSwitchContext(), where the context of
+ * the task is known to be saved.
+ */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_ABORT_ON_MISS == 1 ) )
+
+		static BaseType_t prvAbortMissedJob( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Used with high resolution releases.  Release every task waiting in
+ * vTaskDelayUntilNextRelease() whose release time has been reached, then program
+ * the compare match for the earliest release still to come.  Returns pdTRUE if a
+ * released task should preempt the running task.  Must be called from a critical
+ * section while the scheduler is not suspended, or from the task that suspended it.
+ */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_HIGH_RESOLUTION_RELEASES == 1 ) )
+
+		static BaseType_t prvHRReleaseDueTasks( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * freertos_tasks_c_additions_init() should only be called if the user definable
  * macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is the only macro
@@ -866,6 +1897,10 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 						TCB_t * pxNewTCB;
 						BaseType_t xReturn;
 
+						#if ( configUSE_KERNEL_BENCHMARK == 1 )
+								const uint32_t ulBenchmarkStartTime = configBENCHMARK_COUNTER_VALUE();
+						#endif
+
 						/* If the stack grows down then allocate the stack then the TCB so the stack
 						 * does not grow into the TCB.  Likewise if the stack grows up then allocate
 						 * the TCB then the stack. */
@@ -935,6 +1970,18 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 								prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, xTaskPeriod, pxCreatedTask, pxNewTCB, NULL );
 								prvAddNewTaskToReadyList( pxNewTCB );
 								xReturn = pdPASS;
+
+								#if ( configUSE_KERNEL_BENCHMARK == 1 )
+										{
+												/* Tasks can be created from any task, keep the record
+												 * from being re-entered. */
+												taskENTER_CRITICAL();
+												{
+														prvBenchmarkRecord( tskBENCH_PERIODIC_CREATE, ulBenchmarkStartTime );
+												}
+												taskEXIT_CRITICAL();
+										}
+								#endif
 						}
 						else
 						{
@@ -1017,6 +2064,13 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 						}
 				#endif /* portSTACK_GROWTH */
 
+				#if ( configUSE_STACK_PROFILING == 1 )
+						{
+								pxNewTCB->uxStackDepth = ( configSTACK_DEPTH_TYPE ) ulStackDepth;
+								pxNewTCB->uxStackUsedMax = ( configSTACK_DEPTH_TYPE ) 0U;
+						}
+				#endif /* configUSE_STACK_PROFILING */
+
 				/* Store the task name in the TCB. */
 				if( pcName != NULL )
 				{
@@ -1084,6 +2138,13 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 						}
 				#endif /* portCRITICAL_NESTING_IN_TCB */
 
+				#if ( configUSE_BLOCKING_PROFILER == 1 )
+						{
+								pxNewTCB->uxBlockingDepth = ( UBaseType_t ) 0U;
+								pxNewTCB->ulBlockingSite = 0UL;
+						}
+				#endif
+
 				#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 						{
 								pxNewTCB->pxTaskTag = NULL;
@@ -1271,6 +2332,13 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 						}
 				#endif /* portSTACK_GROWTH */
 
+				#if ( configUSE_STACK_PROFILING == 1 )
+						{
+								pxNewTCB->uxStackDepth = ( configSTACK_DEPTH_TYPE ) ulStackDepth;
+								pxNewTCB->uxStackUsedMax = ( configSTACK_DEPTH_TYPE ) 0U;
+						}
+				#endif /* configUSE_STACK_PROFILING */
+
 				/* Store the task name in the TCB. */
 				if( pcName != NULL )
 				{
@@ -1322,6 +2390,74 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 				#endif /* configUSE_MUTEXES */
 
 				pxNewTCB->xTaskPeriod = xTaskPeriod; /* Fill the new structure's member (xTaskPeriod) on the task TCB */
+				pxNewTCB->xTaskRelativeDeadline = xTaskPeriod; /* Implicit deadline until the application sets another one. */
+				pxNewTCB->xTaskWCET = ( TickType_t ) 0U;
+				#if ( configUSE_SCHEDULER_STATS == 1 )
+						{
+								pxNewTCB->uxDeadlineMisses = ( UBaseType_t ) 0U;
+						}
+				#endif
+				#if ( configUSE_MODE_CHANGE == 1 )
+						{
+								/* The density is 0 until the WCET of the task is known. */
+								pxNewTCB->ucPeriodChangePending = pdFALSE;
+								pxNewTCB->ulTaskDensity = 0UL;
+						}
+				#endif
+				#if ( configUSE_ELASTIC_TASKS == 1 )
+						{
+								pxNewTCB->uxElasticity = ( UBaseType_t ) 0U;
+						}
+				#endif
+				#if ( configUSE_MK_FIRM == 1 )
+						{
+								pxNewTCB->uxMKWindow = ( UBaseType_t ) 0U;
+								pxNewTCB->ucMKWaiting = pdFALSE;
+								pxNewTCB->ucMKSkipped = pdFALSE;
+								pxNewTCB->xMKSkippedWakeTime = ( TickType_t ) 0U;
+								pxNewTCB->ucJobStarted = pdTRUE;
+								pxNewTCB->uxSkippedJobs = ( UBaseType_t ) 0U;
+						}
+				#endif
+				#if ( configUSE_ABORT_ON_MISS == 1 )
+						{
+								pxNewTCB->pxTaskCode = pxTaskCode;
+								pxNewTCB->pvParameters = pvParameters;
+								pxNewTCB->pxInitialTopOfStack = pxTopOfStack;
+								pxNewTCB->ucAbortOnMiss = pdFALSE;
+								pxNewTCB->pxRecoveryHook = NULL;
+								pxNewTCB->uxAbortedJobs = ( UBaseType_t ) 0U;
+								pxNewTCB->ucMissLatched = pdFALSE;
+						}
+				#endif
+				#if ( configUSE_LIMITED_PREEMPTION == 1 )
+						{
+								/* Fully preemptive until the application sets limits. */
+								pxNewTCB->uxNPRNesting = ( UBaseType_t ) 0U;
+								pxNewTCB->xMaxNPRLength = portMAX_DELAY;
+								pxNewTCB->xPreemptionThreshold = ( TickType_t ) 0U;
+						}
+				#endif
+				#if ( configUSE_HIGH_RESOLUTION_RELEASES == 1 )
+						{
+								pxNewTCB->ulHRPeriod = 0UL;
+								pxNewTCB->ucHRWaiting = pdFALSE;
+						}
+				#endif
+				#if ( configUSE_SPORADIC_TASKS == 1 )
+						{
+								pxNewTCB->xMinInterArrival = ( TickType_t ) 0U;
+								pxNewTCB->ucSporadicWaiting = pdFALSE;
+								pxNewTCB->ucSporadicPending = pdFALSE;
+								pxNewTCB->uxRejectedReleases = ( UBaseType_t ) 0U;
+						}
+				#endif
+				#if ( configUSE_MIXED_CRITICALITY == 1 )
+						{
+								pxNewTCB->ucCriticality = tskCRITICALITY_NONE;
+								pxNewTCB->xJobExecution = ( TickType_t ) 0U;
+						}
+				#endif
 				
 				vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
 				vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
@@ -1331,8 +2467,9 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 				 * back to  the containing TCB from a generic item in a list. */
 				listSET_LIST_ITEM_OWNER( &( pxNewTCB->xStateListItem ), pxNewTCB );
 				
-			  /* Setting the item value of the task to its deadline which equal (CurrentTicks + xTaskPeriod). */
-				listSET_LIST_ITEM_VALUE( &( ( pxNewTCB )->xStateListItem ),( TickType_t )((( pxNewTCB)->xTaskPeriod) + CurrentTicks));
+			  /* Release the first job at creation time, this sets the item value of the task to the
+				 * key of the selected policy (the deadline (CurrentTicks + xTaskPeriod) under EDF). */
+				taskPOLICY_RELEASE( pxNewTCB, CurrentTicks );
 				
 				/* Event lists are always in priority order. */
 				listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
@@ -1344,6 +2481,13 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 						}
 				#endif /* portCRITICAL_NESTING_IN_TCB */
 
+				#if ( configUSE_BLOCKING_PROFILER == 1 )
+						{
+								pxNewTCB->uxBlockingDepth = ( UBaseType_t ) 0U;
+								pxNewTCB->ulBlockingSite = 0UL;
+						}
+				#endif
+
 				#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 						{
 								pxNewTCB->pxTaskTag = NULL;
@@ -1578,7 +2722,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 								 * so far. */
 								if( xSchedulerRunning == pdFALSE )
 								{
-										if( pxCurrentTCB->xStateListItem.xItemValue > pxNewTCB->xStateListItem.xItemValue )
+										if( taskPOLICY_SHOULD_PREEMPT( pxNewTCB ) != pdFALSE )
 										{
 												pxCurrentTCB = pxNewTCB;
 										}
@@ -1603,6 +2747,52 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 						#endif /* configUSE_TRACE_FACILITY */
 						traceTASK_CREATE( pxNewTCB );
 
+						#if ( configUSE_EDF_ARRAY == 1 )
+								{
+										UBaseType_t x;
+										BaseType_t xNeedsSlot = ( pxNewTCB != xIdleTaskHandle ) ? pdTRUE : pdFALSE;
+
+										/* Give the task the first free slot.  The idle and release
+										 * tasks do without, their keys are handled in the list. */
+										#if ( configUSE_DEFERRED_RELEASES == 1 )
+												if( pxNewTCB == xReleaseTaskHandle )
+												{
+														xNeedsSlot = pdFALSE;
+												}
+												else
+												{
+														mtCOVERAGE_TEST_MARKER();
+												}
+										#endif
+
+										pxNewTCB->uxReadySlot = tskNO_READY_SLOT;
+
+										for( x = ( UBaseType_t ) 0U; ( x < ( UBaseType_t ) configEDF_ARRAY_SLOTS ) && ( xNeedsSlot != pdFALSE ); x++ )
+										{
+												if( pxReadySlotsEDF[ x ] == NULL )
+												{
+														pxReadySlotsEDF[ x ] = pxNewTCB;
+														xReadyKeysEDF[ x ] = portMAX_DELAY;
+														pxNewTCB->uxReadySlot = x;
+														xNeedsSlot = pdFALSE;
+
+														if( x >= uxReadySlotsUsedEDF )
+														{
+																uxReadySlotsUsedEDF = x + ( UBaseType_t ) 1U;
+														}
+														else
+														{
+																mtCOVERAGE_TEST_MARKER();
+														}
+												}
+												else
+												{
+														mtCOVERAGE_TEST_MARKER();
+												}
+										}
+								}
+						#endif /* configUSE_EDF_ARRAY */
+
 						prvAddTaskToReadyList( pxNewTCB );
 
 						portSETUP_TCB( pxNewTCB );
@@ -1613,7 +2803,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 				{
 						/* If the created task is of an earliest deadline than the current task
 						 * then it should run now. */
-						if( pxCurrentTCB->xStateListItem.xItemValue > pxNewTCB->xStateListItem.xItemValue )
+						if( taskPOLICY_SHOULD_PREEMPT( pxNewTCB ) != pdFALSE )
 						{
 								taskYIELD_IF_USING_PREEMPTION();
 						}
@@ -1662,32 +2852,142 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 mtCOVERAGE_TEST_MARKER();
             }
 
-            /* Increment the uxTaskNumber also so kernel aware debuggers can
-             * detect that the task lists need re-generating.  This is done before
-             * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
-             * not return. */
-            uxTaskNumber++;
-
-            if( pxTCB == pxCurrentTCB )
-            {
-                /* A task is deleting itself.  This cannot complete within the
-                 * task itself, as a context switch to another task is required.
-                 * Place the task in the termination list.  The idle task will
-                 * check the termination list and free up any memory allocated by
-                 * the scheduler for the TCB and stack of the deleted task. */
-                vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
-
-                /* Increment the ucTasksDeleted variable so the idle task knows
-                 * there is a task that has been deleted and that it should therefore
-                 * check the xTasksWaitingTermination list. */
-                ++uxDeletedTasksWaitingCleanUp;
+            #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_MODE_CHANGE == 1 ) )
+                {
+                    /* The deleted task no longer uses its share of the processor. */
+                    ulCommittedDensity -= pxTCB->ulTaskDensity;
+                    ulTargetDensity -= prvTaskTargetDensity( pxTCB );
+                }
+            #endif
 
-                /* Call the delete hook before portPRE_TASK_DELETE_HOOK() as
-                 * portPRE_TASK_DELETE_HOOK() does not return in the Win32 port. */
-                traceTASK_DELETE( pxTCB );
+            #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_ELASTIC_TASKS == 1 ) )
+                {
+                    UBaseType_t x;
 
-                /* The pre-delete hook is primarily for the Windows simulator,
-                 * in which Windows specific clean up operations are performed,
+                    /* Stop adjusting the period of the deleted task. */
+                    for( x = ( UBaseType_t ) 0U; x < uxElasticTasks; x++ )
+                    {
+                        if( pxElasticTasks[ x ] == pxTCB )
+                        {
+                            uxElasticTasks--;
+                            pxElasticTasks[ x ] = pxElasticTasks[ uxElasticTasks ];
+                            break;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+            #endif
+
+            #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_HIGH_RESOLUTION_RELEASES == 1 ) )
+                {
+                    UBaseType_t x;
+
+                    /* Stop programming releases for the deleted task. */
+                    for( x = ( UBaseType_t ) 0U; x < uxHRTasks; x++ )
+                    {
+                        if( pxHRTasks[ x ] == pxTCB )
+                        {
+                            uxHRTasks--;
+                            pxHRTasks[ x ] = pxHRTasks[ uxHRTasks ];
+                            break;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+            #endif
+
+            #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_SPORADIC_TASKS == 1 ) )
+                {
+                    UBaseType_t x;
+
+                    /* Stop releasing postponed arrivals of the deleted task. */
+                    for( x = ( UBaseType_t ) 0U; x < uxSporadicTasks; x++ )
+                    {
+                        if( pxSporadicTasks[ x ] == pxTCB )
+                        {
+                            uxSporadicTasks--;
+                            pxSporadicTasks[ x ] = pxSporadicTasks[ uxSporadicTasks ];
+                            break;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+            #endif
+
+            #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_MIXED_CRITICALITY == 1 ) )
+                {
+                    UBaseType_t x;
+
+                    /* Leave the mixed criticality task set.  The virtual deadline
+                     * factor is not worked out again, the one admitted with the
+                     * task is still valid without it. */
+                    for( x = ( UBaseType_t ) 0U; x < uxCriticalityTasks; x++ )
+                    {
+                        if( pxCriticalityTasks[ x ] == pxTCB )
+                        {
+                            uxCriticalityTasks--;
+                            pxCriticalityTasks[ x ] = pxCriticalityTasks[ uxCriticalityTasks ];
+                            break;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+            #endif
+
+            #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_ARRAY == 1 ) )
+                {
+                    /* Free the slot of the deleted task for the next task created. */
+                    if( pxTCB->uxReadySlot != tskNO_READY_SLOT )
+                    {
+                        pxReadySlotsEDF[ pxTCB->uxReadySlot ] = NULL;
+                        xReadyKeysEDF[ pxTCB->uxReadySlot ] = portMAX_DELAY;
+                        ulReadyMaskEDF &= ~( 1UL << pxTCB->uxReadySlot );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            #endif
+
+            /* Increment the uxTaskNumber also so kernel aware debuggers can
+             * detect that the task lists need re-generating.  This is done before
+             * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
+             * not return. */
+            uxTaskNumber++;
+
+            if( pxTCB == pxCurrentTCB )
+            {
+                /* A task is deleting itself.  This cannot complete within the
+                 * task itself, as a context switch to another task is required.
+                 * Place the task in the termination list.  The idle task will
+                 * check the termination list and free up any memory allocated by
+                 * the scheduler for the TCB and stack of the deleted task. */
+                vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
+
+                /* Increment the ucTasksDeleted variable so the idle task knows
+                 * there is a task that has been deleted and that it should therefore
+                 * check the xTasksWaitingTermination list. */
+                ++uxDeletedTasksWaitingCleanUp;
+
+                /* Call the delete hook before portPRE_TASK_DELETE_HOOK() as
+                 * portPRE_TASK_DELETE_HOOK() does not return in the Win32 port. */
+                traceTASK_DELETE( pxTCB );
+
+                /* The pre-delete hook is primarily for the Windows simulator,
+                 * in which Windows specific clean up operations are performed,
                  * after which it is not possible to yield away from this task -
                  * hence xYieldPending is used to latch that a context switch is
                  * required. */
@@ -1733,6 +3033,10 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
         TickType_t xTimeToWake;
         BaseType_t xAlreadyYielded, xShouldDelay = pdFALSE;
 
+        #if ( configUSE_KERNEL_BENCHMARK == 1 )
+            const uint32_t ulBenchmarkStartTime = configBENCHMARK_COUNTER_VALUE();
+        #endif
+
         configASSERT( pxPreviousWakeTime );
         configASSERT( ( xTimeIncrement > 0U ) );
         configASSERT( uxSchedulerSuspended == 0 );
@@ -1746,6 +3050,32 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             /* Generate the tick time at which the task wants to wake. */
             xTimeToWake = *pxPreviousWakeTime + xTimeIncrement;
 
+            #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_SCHEDULER_STATS == 1 ) )
+                {
+                    /* Calling this function ends the current job, so check it
+                     * against its deadline.  The difference is signed so the
+                     * check holds across a tick count wrap. */
+                    if( ( BaseType_t ) ( xConstTickCount - pxCurrentTCB->xTaskAbsoluteDeadline ) > 0 )
+                    {
+                        ( pxCurrentTCB->uxDeadlineMisses )++;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            #endif
+
+            #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_MK_FIRM == 1 ) )
+                {
+                    /* Record whether the job that just ended met its deadline, and
+                     * let the tick handler skip the next release. */
+                    prvMKRecordOutcome( pxCurrentTCB, ( ( BaseType_t ) ( xConstTickCount - pxCurrentTCB->xTaskAbsoluteDeadline ) <= 0 ) ? pdTRUE : pdFALSE );
+                    pxCurrentTCB->ucMKWaiting = pdTRUE;
+                    pxCurrentTCB->ucMKSkipped = pdFALSE;
+                }
+            #endif
+
             if( xConstTickCount < *pxPreviousWakeTime )
             {
                 /* The tick count has overflowed since this function was
@@ -1771,26 +3101,71 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 {
                     xShouldDelay = pdTRUE;
                 }
-								#if (configUSE_EDF_SCHEDULER==1)
-										/* Used with EDF scheduler if the (xTimeToWake <= xConstTickCount)
-								     * to reallocate the task in the xReadyTasksListEDF list with its new deadline.
-										 */
-										else if(xTimeToWake <= xConstTickCount)
-										{
-												/* Firstly Remove the task from xReadyTasksListEDF list. */
-												uxListRemove( &( pxCurrentTCB->xStateListItem ) );
-												/* Then setting the item value of the task to its new deadline which equal (xTimeToWake + xTimeIncrement). */
-												listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake+xTimeIncrement );
-												/* Then adding the task again to the xReadyTasksListEDF list according to its new deadline. */
-												prvAddTaskToReadyList( pxCurrentTCB );
-										}
-								#endif
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
 
+            #if ( configUSE_EDF_SCHEDULER == 1 )
+                {
+                    /* The next job is already due, whether or not the tick
+                     * count has overflowed. */
+                    if( xShouldDelay == pdFALSE )
+                    {
+                        #if ( configUSE_MK_FIRM == 1 )
+                            {
+                                /* The next job is released late, which means the system is
+                                 * overloaded.  If the task can afford to lose it then skip it
+                                 * rather than running a job that makes the following ones late
+                                 * too. */
+                                if( ( pxCurrentTCB->uxMKWindow > ( UBaseType_t ) 0U ) && ( prvMKDistanceToFailure( pxCurrentTCB ) > ( UBaseType_t ) 0U ) )
+                                {
+                                    prvMKRecordOutcome( pxCurrentTCB, pdFALSE );
+                                    ( pxCurrentTCB->uxSkippedJobs )++;
+
+                                    /* Less than a period late, the job after it is not due
+                                     * yet. */
+                                    if( ( TickType_t ) ( xConstTickCount - xTimeToWake ) < xTimeIncrement )
+                                    {
+                                        xShouldDelay = pdTRUE;
+                                    }
+                                    else
+                                    {
+                                        mtCOVERAGE_TEST_MARKER();
+                                    }
+
+                                    xTimeToWake += xTimeIncrement;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                        #endif /* configUSE_MK_FIRM */
+
+                        if( xShouldDelay == pdFALSE )
+                        {
+                            /* Release the late job at xTimeToWake, the time it was
+                             * due, so its deadline (xTimeToWake + xTimeIncrement) does
+                             * not drift by how late it is.  Move the task in the
+                             * xReadyTasksListEDF list according to that deadline. */
+                            ( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+                            taskPOLICY_RELEASE( pxCurrentTCB, xTimeToWake );
+                            prvAddTaskToReadyList( pxCurrentTCB );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            #endif /* configUSE_EDF_SCHEDULER */
+
             /* Update the wake time ready for the next call. */
             *pxPreviousWakeTime = xTimeToWake;
 
@@ -1806,6 +3181,14 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             {
                 mtCOVERAGE_TEST_MARKER();
             }
+
+            #if ( configUSE_KERNEL_BENCHMARK == 1 )
+                {
+                    /* Measured up to here, what follows is the switch to the
+                     * next task which is measured on its own. */
+                    prvBenchmarkRecord( tskBENCH_DELAY_UNTIL, ulBenchmarkStartTime );
+                }
+            #endif
         }
         xAlreadyYielded = xTaskResumeAll();
 
@@ -1820,6 +3203,27 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             mtCOVERAGE_TEST_MARKER();
         }
 
+        #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_MK_FIRM == 1 ) )
+            {
+                /* If the release waited for was skipped, the task was held
+                 * until a later one.  Move the wake time on to it here, from
+                 * the task that owns it, so the skipped job is not run late. */
+                taskENTER_CRITICAL();
+                {
+                    if( pxCurrentTCB->ucMKSkipped != pdFALSE )
+                    {
+                        pxCurrentTCB->ucMKSkipped = pdFALSE;
+                        *pxPreviousWakeTime = pxCurrentTCB->xMKSkippedWakeTime;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+            }
+        #endif
+
         return xShouldDelay;
     }
 
@@ -2072,7 +3476,10 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             if( uxCurrentBasePriority != uxNewPriority )
             {
                 /* The priority change may have readied a task of higher
-                 * priority than the calling task. */
+                 * priority than the calling task.  Under EDF the ready tasks
+                 * are ordered by their policy key, which the priority is not
+                 * part of, so no yield is required. */
+                #if ( configUSE_EDF_SCHEDULER == 0 )
                 if( uxNewPriority > uxCurrentBasePriority )
                 {
                     if( pxTCB != pxCurrentTCB )
@@ -2109,6 +3516,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                      * require a yield as the running task must be above the
                      * new priority of the task being modified. */
                 }
+                #endif /* configUSE_EDF_SCHEDULER */
 
                 /* Remember the ready list the task might be referenced from
                  * before its uxPriority member is changed so the
@@ -2138,15 +3546,18 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 #endif /* if ( configUSE_MUTEXES == 1 ) */
 
                 /* Only reset the event list item value if the value is not
-                 * being used for anything else. */
-                if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
-                {
-                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                 * being used for anything else.  Under EDF it holds the policy
+                 * key the task waits by, which does not depend on the priority. */
+                #if ( configUSE_EDF_SCHEDULER == 0 )
+                    if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+                    {
+                        listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                #endif /* configUSE_EDF_SCHEDULER */
 
                 /* If the task is in the blocked or suspended list we need do
                  * nothing more than change its priority variable. However, if
@@ -2370,10 +3781,24 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                     /* The ready list can be accessed even if the scheduler is
                      * suspended because this is inside a critical section. */
                     ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+                    #if ( configUSE_EDF_SCHEDULER == 1 )
+                        {
+                            /* The task carries on with its current job, the
+                             * delayed list may have left its wake time in the
+                             * item value. */
+                            listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), ( TickType_t ) taskPOLICY_KEY( pxTCB ) );
+                        }
+                    #endif
+
                     prvAddTaskToReadyList( pxTCB );
 
                     /* A higher priority task may have just been resumed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #if ( configUSE_EDF_SCHEDULER == 1 )
+                        if( taskPOLICY_SHOULD_PREEMPT( pxTCB ) != pdFALSE )
+                    #else
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #endif
                     {
                         /* This yield may not cause the task just resumed to run,
                          * but will leave the lists in the correct state for the
@@ -2441,7 +3866,21 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 {
                     /* Ready lists can be accessed so move the task from the
                      * suspended list to the ready list directly. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #if ( configUSE_EDF_SCHEDULER == 1 )
+                        {
+                            /* The keys are compared once the task is in the
+                             * ready list. */
+                            ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                            listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), ( TickType_t ) taskPOLICY_KEY( pxTCB ) );
+                            prvAddTaskToReadyList( pxTCB );
+                        }
+                    #endif
+
+                    #if ( configUSE_EDF_SCHEDULER == 1 )
+                        if( taskPOLICY_SHOULD_PREEMPT( pxTCB ) != pdFALSE )
+                    #else
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #endif
                     {
                         xYieldRequired = pdTRUE;
 
@@ -2455,8 +3894,12 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                         mtCOVERAGE_TEST_MARKER();
                     }
 
-                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
+                    #if ( configUSE_EDF_SCHEDULER == 0 )
+                        {
+                            ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                            prvAddTaskToReadyList( pxTCB );
+                        }
+                    #endif
                 }
                 else
                 {
@@ -2535,6 +3978,49 @@ void vTaskStartScheduler( void )
         }
     #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+    #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_DEFERRED_RELEASES == 1 ) )
+        {
+            if( xReturn == pdPASS )
+            {
+                xReturn = xTaskPeriodicCreate( prvReleaseTask,
+                                               configRELEASE_TASK_NAME,
+                                               configRELEASE_TASK_STACK_SIZE,
+                                               ( void * ) NULL,
+                                               portPRIVILEGE_BIT,
+                                               ( TickType_t ) 100U, /* Not used, the task has no jobs of its own. */
+                                               &xReleaseTaskHandle );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xReturn == pdPASS )
+            {
+                /* The release task only becomes ready when there is
+                 * something to release. */
+                taskENTER_CRITICAL();
+                {
+                    ( void ) uxListRemove( &( xReleaseTaskHandle->xStateListItem ) );
+
+                    if( pxCurrentTCB == xReleaseTaskHandle )
+                    {
+                        taskPOLICY_SELECT();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #endif /* configUSE_DEFERRED_RELEASES */
+
     #if ( configUSE_TIMERS == 1 )
         {
             if( xReturn == pdPASS )
@@ -2646,6 +4132,21 @@ void vTaskSuspendAll( void )
      * is used to allow calls to vTaskSuspendAll() to nest. */
     ++uxSchedulerSuspended;
 
+    #if ( configUSE_BLOCKING_PROFILER == 1 )
+        {
+            /* Only the outermost suspension is measured. */
+            if( uxSchedulerSuspended == ( UBaseType_t ) 1U )
+            {
+                ulBlockingSuspendStart = configBLOCKING_PROFILER_COUNTER_VALUE();
+                ulBlockingSuspendSite = configBLOCKING_PROFILER_CALLER();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #endif
+
     /* Enforces ordering for ports and optimised compilers that may otherwise place
      * the above increment elsewhere. */
     portMEMORY_BARRIER();
@@ -2735,6 +4236,12 @@ BaseType_t xTaskResumeAll( void )
 
         if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
         {
+            #if ( configUSE_BLOCKING_PROFILER == 1 )
+                {
+                    prvBlockingRecord( tskBLOCK_SCHEDULER_SUSPENDED, ulBlockingSuspendStart, ulBlockingSuspendSite );
+                }
+            #endif
+
             if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
             {
                 /* Move any readied tasks from the pending list into the
@@ -2744,11 +4251,40 @@ BaseType_t xTaskResumeAll( void )
                     pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
                     ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
                     ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+                    #if ( configUSE_EDF_SCHEDULER == 1 )
+                        {
+                            /* The task carries on with its current job, the
+                             * delayed list left its wake time in the item value. */
+                            listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), ( TickType_t ) taskPOLICY_KEY( pxTCB ) );
+                        }
+                    #endif
+
                     prvAddTaskToReadyList( pxTCB );
 
+                    #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_MK_FIRM == 1 ) )
+                        {
+                            /* A job released from an interrupt while the scheduler
+                             * was suspended, see prvSporadicRelease(), gets the
+                             * overload check of the releases made directly. */
+                            if( pxTCB->ucJobStarted == pdFALSE )
+                            {
+                                prvMKShedLoad( pxTCB );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                    #endif
+
                     /* If the moved task has a priority higher than the current
                      * task then a yield must be performed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #if ( configUSE_EDF_SCHEDULER == 1 )
+                        if( taskPOLICY_SHOULD_PREEMPT( pxTCB ) != pdFALSE )
+                    #else
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #endif
                     {
                         xYieldPending = pdTRUE;
                     }
@@ -2778,6 +4314,15 @@ BaseType_t xTaskResumeAll( void )
 
                     if( xPendedCounts > ( TickType_t ) 0U )
                     {
+                        #if ( configUSE_BLOCKING_PROFILER == 1 )
+                            {
+                                /* These ticks, including the ones replayed for
+                                 * xTaskCatchUpTicks(), are run from this critical
+                                 * section and timed as part of it. */
+                                xBlockingReplayingTicks = pdTRUE;
+                            }
+                        #endif
+
                         do
                         {
                             if( xTaskIncrementTick() != pdFALSE )
@@ -2793,6 +4338,12 @@ BaseType_t xTaskResumeAll( void )
                         } while( xPendedCounts > ( TickType_t ) 0U );
 
                         xPendedTicks = 0;
+
+                        #if ( configUSE_BLOCKING_PROFILER == 1 )
+                            {
+                                xBlockingReplayingTicks = pdFALSE;
+                            }
+                        #endif
                     }
                     else
                     {
@@ -2800,15 +4351,39 @@ BaseType_t xTaskResumeAll( void )
                     }
                 }
 
-                if( xYieldPending != pdFALSE )
-                {
-                    #if ( configUSE_PREEMPTION != 0 )
+                #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_HIGH_RESOLUTION_RELEASES == 1 ) )
+                    {
+                        /* Release the tasks whose compare match came while the
+                         * scheduler was suspended. */
+                        if( xHRReleasePending != pdFALSE )
                         {
-                            xAlreadyYielded = pdTRUE;
-                        }
-                    #endif
-                    taskYIELD_IF_USING_PREEMPTION();
-                }
+                            xHRReleasePending = pdFALSE;
+
+                            if( prvHRReleaseDueTasks() != pdFALSE )
+                            {
+                                xYieldPending = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                #endif /* configUSE_HIGH_RESOLUTION_RELEASES */
+
+                if( xYieldPending != pdFALSE )
+                {
+                    #if ( configUSE_PREEMPTION != 0 )
+                        {
+                            xAlreadyYielded = pdTRUE;
+                        }
+                    #endif
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
@@ -3052,7 +4627,10 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
 								{
 										/* Using with EDF scheduler to Fill in an TaskStatus_t structure 
 										 * with information on each task in the Ready state. */
-										uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) &xReadyTasksListEDF, eReady );
+										for( uxQueue = ( UBaseType_t ) 0U; uxQueue < tskEDF_READY_LISTS; uxQueue++ )
+										{
+												uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) taskEDF_READY_LIST( uxQueue ), eReady );
+										}
 								}
 								#endif
 
@@ -3204,6 +4782,14 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                 }
                 taskEXIT_CRITICAL();
 
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    {
+                        /* The task carries on with its current job, the delayed
+                         * list left its wake time in the item value. */
+                        listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), ( TickType_t ) taskPOLICY_KEY( pxTCB ) );
+                    }
+                #endif
+
                 /* Place the unblocked task into the appropriate ready list. */
                 prvAddTaskToReadyList( pxTCB );
 
@@ -3214,7 +4800,11 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                         /* Preemption is on, but a context switch should only be
                          *  performed if the unblocked task has a priority that is
                          *  equal to or higher than the currently executing task. */
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        #if ( configUSE_EDF_SCHEDULER == 1 )
+                            if( taskPOLICY_SHOULD_PREEMPT( pxTCB ) != pdFALSE )
+                        #else
+                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        #endif
                         {
                             /* Pend the yield to be performed when the scheduler
                              * is unsuspended. */
@@ -3246,6 +4836,22 @@ BaseType_t xTaskIncrementTick( void )
     TickType_t xItemValue;
     BaseType_t xSwitchRequired = pdFALSE;
 
+    #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_SCHEDULER_STATS == 1 ) )
+        const uint32_t ulEntryTime = configBENCHMARK_COUNTER_VALUE();
+    #endif
+
+    #if ( configUSE_KERNEL_BENCHMARK == 1 )
+        const uint32_t ulBenchmarkStartTime = configBENCHMARK_COUNTER_VALUE();
+    #endif
+
+    #if ( configUSE_BLOCKING_PROFILER == 1 )
+        const uint32_t ulBlockingProfilerStartTime = configBLOCKING_PROFILER_COUNTER_VALUE();
+    #endif
+
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        TickType_t xReleaseTime;
+    #endif
+
     /* Called by the portable layer each time a tick interrupt occurs.
      * Increments the tick then checks to see if the new tick value will cause any
      * tasks to be unblocked. */
@@ -3352,15 +4958,60 @@ BaseType_t xTaskIncrementTick( void )
 										}
 										#else
 										{
-												/* Setting the item value of the unblocked task to its new deadline which equal (xTaskPeriod + xConstTickCount). */
-												listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), (TickType_t)((( pxTCB)->xTaskPeriod) + xConstTickCount));
+												/* The job is released at its wake time rather than at the tick
+												 * that gets round to it, so its deadline does not drift. */
+												xReleaseTime = xItemValue;
+
+												#if ( configUSE_HIGH_RESOLUTION_RELEASES == 1 )
+														if( pxTCB->ucHRWaiting != pdFALSE )
+														{
+																/* The compare match of a high resolution release was lost, the
+																 * tick is the backstop that releases the task instead, at the
+																 * time the match was due. */
+																pxTCB->ucHRWaiting = pdFALSE;
+																xReleaseTime = tskHR_RELEASE_TICK( configHR_TIMER_COUNT() - pxTCB->ulHRRelease );
+														}
+														else
+														{
+																mtCOVERAGE_TEST_MARKER();
+														}
+												#endif
+
+												#if ( configUSE_DEFERRED_RELEASES == 1 )
+												{
+														/* Only queue the task, the release task gives the job its
+														 * deadline and sorts it into the ready list. */
+														listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), xReleaseTime );
+														vListInsertEnd( &xPendingReleaseList, &( pxTCB->xStateListItem ) );
+
+														if( prvReleaseTaskWake() != pdFALSE )
+														{
+																xSwitchRequired = pdTRUE;
+														}
+														else
+														{
+																mtCOVERAGE_TEST_MARKER();
+														}
+												}
+												#else
+												{
+												/* Releasing the next job of the unblocked task, under EDF its new deadline equal (xTaskPeriod + xReleaseTime). */
+												taskPOLICY_RELEASE( pxTCB, xReleaseTime );
 											
 												/* Placing the unblocked task to the xReadyTasksListEDF list according to its new deadline. */
 												prvAddTaskToReadyList( pxTCB );
 												
+												#if ( configUSE_MK_FIRM == 1 )
+														/* If the released job can not meet its deadline skip the optional
+														 * job that is furthest from failing its (m,k) constraint.  That can
+														 * be the job just released, in which case it is no longer ready. */
+														prvMKShedLoad( pxTCB );
+												#endif
+												
 												/* A context switch should only be performed if the unblocked task has a
 												 * deadline that is less than the currently executing task. */
-												if( pxTCB->xStateListItem.xItemValue < pxCurrentTCB->xStateListItem.xItemValue )
+												if( ( taskIS_READY_EDF( pxTCB ) != pdFALSE ) &&
+														( taskPOLICY_SHOULD_PREEMPT( pxTCB ) != pdFALSE ) )
 												{
 														xSwitchRequired = pdTRUE;
 												}
@@ -3368,6 +5019,8 @@ BaseType_t xTaskIncrementTick( void )
 												{
 														mtCOVERAGE_TEST_MARKER();
 												}
+												}
+												#endif /* configUSE_DEFERRED_RELEASES */
 											
 										}
 										#endif
@@ -3376,6 +5029,102 @@ BaseType_t xTaskIncrementTick( void )
             }
         }
 
+        #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_SPORADIC_TASKS == 1 ) )
+            {
+                /* Release the postponed arrivals that are now due. */
+                prvSporadicTick( &xSwitchRequired );
+            }
+        #endif /* configUSE_SPORADIC_TASKS */
+
+        #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_MIXED_CRITICALITY == 1 ) )
+            {
+                /* Charge the tick to the running job and check its budget. */
+                prvCriticalityTick( &xSwitchRequired );
+            }
+        #endif /* configUSE_MIXED_CRITICALITY */
+
+        #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_ABORT_ON_MISS == 1 ) )
+            {
+                /* The running job has missed its deadline.  It is aborted by
+                 * vTaskSwitchContext() once its context has been saved, unless
+                 * that was already refused for this job. */
+                if( ( pxCurrentTCB->ucAbortOnMiss != pdFALSE ) &&
+                    ( pxCurrentTCB->ucMissLatched == pdFALSE ) &&
+                    ( ( BaseType_t ) ( xTickCount - pxCurrentTCB->xTaskAbsoluteDeadline ) > 0 ) )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configUSE_ABORT_ON_MISS */
+
+        #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_LIMITED_PREEMPTION == 1 ) )
+            {
+                /* A held off preemption happens once the non-preemptive region
+                 * has lasted as long as it is allowed to. */
+                if( ( xPreemptionDeferred != pdFALSE ) &&
+                    ( ( TickType_t ) ( xTickCount - pxCurrentTCB->xNPRStartTime ) >= pxCurrentTCB->xMaxNPRLength ) )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configUSE_LIMITED_PREEMPTION */
+
+        #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_MK_FIRM == 1 ) && ( configSCHEDULING_POLICY != tskPOLICY_LLF ) )
+            {
+                /* Charge the tick to the running job so the overload test in
+                 * prvMKShedLoad() knows how much work is left. */
+                if( ( pxCurrentTCB != xIdleTaskHandle ) && ( pxCurrentTCB->xTaskRemainingExecution > ( TickType_t ) 0U ) )
+                {
+                    ( pxCurrentTCB->xTaskRemainingExecution )--;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configUSE_MK_FIRM */
+
+        #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configSCHEDULING_POLICY == tskPOLICY_LLF ) )
+            {
+                /* The laxity of the running job stays constant while it executes
+                 * and the laxity of the waiting jobs shrinks, so charge the tick to
+                 * the running job and re-sort it - the key of the running job
+                 * (deadline - remaining execution) grows by one. */
+                if( ( pxCurrentTCB != xIdleTaskHandle ) &&
+                    ( taskIS_READY_EDF( pxCurrentTCB ) != pdFALSE ) &&
+                    ( pxCurrentTCB->xTaskRemainingExecution > ( TickType_t ) 0U ) )
+                {
+                    ( pxCurrentTCB->xTaskRemainingExecution )--;
+                    ( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+                    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), ( TickType_t ) taskPOLICY_KEY( pxCurrentTCB ) );
+                    prvAddTaskToReadyList( pxCurrentTCB );
+
+                    pxTCB = taskREADY_SET_HEAD();
+
+                    if( taskPOLICY_SHOULD_PREEMPT( pxTCB ) != pdFALSE )
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configSCHEDULING_POLICY == tskPOLICY_LLF */
+
         /* Tasks of equal priority to the currently running task will share
          * processing time (time slice) if preemption is on, and the application
          * writer has not explicitly turned time slicing off. */
@@ -3433,6 +5182,34 @@ BaseType_t xTaskIncrementTick( void )
         #endif
     }
 
+    #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_SCHEDULER_STATS == 1 ) )
+        {
+            ulKernelOverheadTime += ( configBENCHMARK_COUNTER_VALUE() - ulEntryTime );
+        }
+    #endif
+
+    #if ( configUSE_KERNEL_BENCHMARK == 1 )
+        {
+            prvBenchmarkRecord( tskBENCH_INCREMENT_TICK, ulBenchmarkStartTime );
+        }
+    #endif
+
+    #if ( configUSE_BLOCKING_PROFILER == 1 )
+        {
+            /* Only the tick interrupt is attributed to the tick handler.
+             * Pended ticks are processed from the critical section of
+             * xTaskResumeAll(), which is measured already. */
+            if( xBlockingReplayingTicks == pdFALSE )
+            {
+                prvBlockingRecord( tskBLOCK_INTERRUPTS_MASKED, ulBlockingProfilerStartTime, tskBLOCK_SITE_TICK );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #endif
+
     return xSwitchRequired;
 }
 /*-----------------------------------------------------------*/
@@ -3459,120 +5236,3120 @@ TickType_t vTaskGetApplicationTaskItemValue( TaskHandle_t xTask )
 #endif /* configUSE_APPLICATION_TASK_ITEM_VALUE */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
-
-    void vTaskSetApplicationTaskTag( TaskHandle_t xTask,
-                                     TaskHookFunction_t pxHookFunction )
-    {
-        TCB_t * xTCB;
+#if ( configUSE_EDF_SCHEDULER == 1 )
 
-        /* If xTask is NULL then it is the task hook of the calling task that is
-         * getting set. */
-        if( xTask == NULL )
-        {
-            xTCB = ( TCB_t * ) pxCurrentTCB;
-        }
-        else
-        {
-            xTCB = xTask;
-        }
+		/* Used with the LLF policy: the laxity of a job is computed from the deadline
+		 * and the execution time the job still needs, so the application has to give
+		 * the worst case execution time (in ticks) of one job of the task. */
+		void vTaskSetWorstCaseExecutionTime( TaskHandle_t xTask,
+																				 TickType_t xWCET )
+		{
+				TCB_t * pxTCB;
 
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
-        taskENTER_CRITICAL();
-        {
-            xTCB->pxTaskTag = pxHookFunction;
-        }
-        taskEXIT_CRITICAL();
-    }
+				/* If xTask is NULL then set the calling task's execution time. */
+				pxTCB = prvGetTCBFromHandle( xTask );
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
-/*-----------------------------------------------------------*/
+				/* A critical section is required as the value is used from the tick interrupt. */
+				taskENTER_CRITICAL();
+				{
+						#if ( configUSE_MODE_CHANGE == 1 )
+								{
+										/* The task's share of the processor changes with its WCET. */
+										ulTargetDensity -= prvTaskTargetDensity( pxTCB );
+										ulCommittedDensity -= pxTCB->ulTaskDensity;
+								}
+						#endif
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+						pxTCB->xTaskWCET = xWCET;
 
-    TaskHookFunction_t xTaskGetApplicationTaskTag( TaskHandle_t xTask )
-    {
-        TCB_t * pxTCB;
-        TaskHookFunction_t xReturn;
+						#if ( configUSE_MODE_CHANGE == 1 )
+								{
+										pxTCB->ulTaskDensity = prvTaskDensity( xWCET, pxTCB->xTaskPeriod, pxTCB->xTaskRelativeDeadline );
+										ulCommittedDensity += pxTCB->ulTaskDensity;
+										ulTargetDensity += prvTaskTargetDensity( pxTCB );
+								}
+						#endif
+				}
+				taskEXIT_CRITICAL();
+		}
+/*-----------------------------------------------------------*/
 
-        /* If xTask is NULL then set the calling task's hook. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+		TickType_t xTaskGetAbsoluteDeadline( TaskHandle_t xTask )
+		{
+				TCB_t * pxTCB;
+				TickType_t xReturn;
 
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
-        taskENTER_CRITICAL();
-        {
-            xReturn = pxTCB->pxTaskTag;
-        }
-        taskEXIT_CRITICAL();
+				/* If xTask is NULL then get the calling task's deadline. */
+				pxTCB = prvGetTCBFromHandle( xTask );
 
-        return xReturn;
-    }
+				/* The deadline is the item value only under EDF, so read the TCB member
+				 * that holds it for every policy.  A critical section is required as the
+				 * value can be changed from an interrupt. */
+				taskENTER_CRITICAL();
+				{
+						xReturn = pxTCB->xTaskAbsoluteDeadline;
+				}
+				taskEXIT_CRITICAL();
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+				return xReturn;
+		}
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
-
-    TaskHookFunction_t xTaskGetApplicationTaskTagFromISR( TaskHandle_t xTask )
-    {
-        TCB_t * pxTCB;
-        TaskHookFunction_t xReturn;
-        UBaseType_t uxSavedInterruptStatus;
+		TickType_t xTaskGetReleaseTime( TaskHandle_t xTask )
+		{
+				TCB_t * pxTCB;
+				TickType_t xReturn;
 
-        /* If xTask is NULL then set the calling task's hook. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+				/* If xTask is NULL then get the release time of the calling task's
+				 * job. */
+				pxTCB = prvGetTCBFromHandle( xTask );
 
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
-        {
-            xReturn = pxTCB->pxTaskTag;
-        }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+				/* A task that restarts at its entry point, after its job was aborted,
+				 * takes its last wake time from here to keep its phase. */
+				taskENTER_CRITICAL();
+				{
+						xReturn = pxTCB->xTaskAbsoluteDeadline - pxTCB->xTaskRelativeDeadline;
+				}
+				taskEXIT_CRITICAL();
 
-        return xReturn;
-    }
+				return xReturn;
+		}
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+#endif /* configUSE_EDF_SCHEDULER */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_MODE_CHANGE == 1 ) )
 
-    BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
-                                             void * pvParameter )
-    {
-        TCB_t * xTCB;
-        BaseType_t xReturn;
+		static uint32_t prvTaskDensity( TickType_t xWCET,
+																		TickType_t xPeriod,
+																		TickType_t xDeadline )
+		{
+				TickType_t xWindow;
 
-        /* If xTask is NULL then we are calling our own task hook. */
-        if( xTask == NULL )
-        {
-            xTCB = pxCurrentTCB;
-        }
-        else
-        {
-            xTCB = xTask;
-        }
+				/* A job has to complete within the shorter of its deadline and its period. */
+				xWindow = ( xDeadline < xPeriod ) ? xDeadline : xPeriod;
+				configASSERT( xWindow > ( TickType_t ) 0U );
 
-        if( xTCB->pxTaskTag != NULL )
-        {
-            xReturn = xTCB->pxTaskTag( pvParameter );
-        }
-        else
-        {
-            xReturn = pdFAIL;
-        }
+				return ( uint32_t ) ( ( ( uint32_t ) xWCET << tskDENSITY_SHIFT ) / ( uint32_t ) xWindow );
+		}
+/*-----------------------------------------------------------*/
 
-        return xReturn;
-    }
+		static uint32_t prvTaskTargetDensity( const TCB_t * pxTCB )
+		{
+				uint32_t ulReturn;
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
-/*-----------------------------------------------------------*/
+				/* The density the task will have once its pending change (if any) is applied. */
+				if( pxTCB->ucPeriodChangePending != pdFALSE )
+				{
+						ulReturn = prvTaskDensity( pxTCB->xTaskWCET, pxTCB->xTaskPendingPeriod, pxTCB->xTaskPendingDeadline );
+				}
+				else
+				{
+						ulReturn = pxTCB->ulTaskDensity;
+				}
+
+				return ulReturn;
+		}
+/*-----------------------------------------------------------*/
+
+		static void prvApplyPendingPeriodChange( TCB_t * pxTCB )
+		{
+				uint32_t ulNewDensity;
+
+				if( pxTCB->ucPeriodChangePending != pdFALSE )
+				{
+						ulNewDensity = prvTaskDensity( pxTCB->xTaskWCET, pxTCB->xTaskPendingPeriod, pxTCB->xTaskPendingDeadline );
+
+						/* The change is only applied at a job boundary, so the current job
+						 * always completes with the parameters it was released with.  A task
+						 * that asks for less of the processor can switch straight away, its
+						 * next release is not before the deadline of the job that just ended.
+						 * A task that asks for more has to wait until the tasks leaving the
+						 * old mode have given their share back. */
+						if( ( ulNewDensity <= pxTCB->ulTaskDensity ) ||
+								( ( ulCommittedDensity - pxTCB->ulTaskDensity + ulNewDensity ) <= ( uint32_t ) configMODE_CHANGE_DENSITY_BOUND ) )
+						{
+								ulCommittedDensity = ( ulCommittedDensity - pxTCB->ulTaskDensity ) + ulNewDensity;
+								pxTCB->ulTaskDensity = ulNewDensity;
+								pxTCB->xTaskPeriod = pxTCB->xTaskPendingPeriod;
+								pxTCB->xTaskRelativeDeadline = pxTCB->xTaskPendingDeadline;
+								pxTCB->ucPeriodChangePending = pdFALSE;
+
+								#if ( configUSE_MIXED_CRITICALITY == 1 )
+										{
+												if( pxTCB->ucCriticality != tskCRITICALITY_NONE )
+												{
+														prvCriticalityVirtualDeadline( pxTCB );
+												}
+												else
+												{
+														mtCOVERAGE_TEST_MARKER();
+												}
+										}
+								#endif
+						}
+						else
+						{
+								/* Keep the old parameters for one more job and retry at the next
+								 * job boundary. */
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+		}
+/*-----------------------------------------------------------*/
+
+		BaseType_t xTaskSetMode( const TaskHandle_t * const pxTasks,
+														 const TickType_t * const pxPeriods,
+														 const TickType_t * const pxDeadlines,
+														 UBaseType_t uxNumberOfTasks )
+		{
+				TCB_t * pxTCB;
+				TickType_t xDeadline;
+				uint32_t ulNewTargetDensity;
+				UBaseType_t x;
+				BaseType_t xReturn;
+
+				#if ( configUSE_MIXED_CRITICALITY == 1 )
+						CriticalityChange_t xChange;
+						uint32_t ulFactor = ulCriticalityFactor;
+				#endif
+
+				configASSERT( pxTasks );
+				configASSERT( pxPeriods );
+
+				taskENTER_CRITICAL();
+				{
+						/* Work out the density of the whole task set in the new mode, that
+						 * is once every pending change has been applied.  If the new mode is
+						 * not schedulable it could never be reached safely, so nothing is
+						 * changed. */
+						ulNewTargetDensity = ulTargetDensity;
+
+						for( x = ( UBaseType_t ) 0U; x < uxNumberOfTasks; x++ )
+						{
+								configASSERT( pxPeriods[ x ] > ( TickType_t ) 0U );
+
+								/* A NULL deadline array or a deadline of 0 means an implicit
+								 * deadline (equal to the period). */
+								xDeadline = ( ( pxDeadlines == NULL ) || ( pxDeadlines[ x ] == ( TickType_t ) 0U ) ) ? pxPeriods[ x ] : pxDeadlines[ x ];
+								pxTCB = prvGetTCBFromHandle( pxTasks[ x ] );
+								ulNewTargetDensity = ( ulNewTargetDensity - prvTaskTargetDensity( pxTCB ) ) + prvTaskDensity( pxTCB->xTaskWCET, pxPeriods[ x ], xDeadline );
+						}
+
+						xReturn = ( ulNewTargetDensity <= ( uint32_t ) configMODE_CHANGE_DENSITY_BOUND ) ? pdPASS : pdFAIL;
+
+						#if ( configUSE_MIXED_CRITICALITY == 1 )
+								{
+										/* A density bound does not cover HI mode, where the HI tasks run
+										 * to their HI budget.  The new periods of a mixed criticality task
+										 * set, elastic ones included, have to pass EDF-VD as well. */
+										if( ( xReturn != pdFAIL ) && ( uxCriticalityTasks > ( UBaseType_t ) 0U ) )
+										{
+												xChange.pxTasks = pxTasks;
+												xChange.pxPeriods = pxPeriods;
+												xChange.pxDeadlines = pxDeadlines;
+												xChange.uxNumberOfTasks = uxNumberOfTasks;
+												ulFactor = prvCriticalityTest( NULL, pdFALSE, ( TickType_t ) 0U, ( TickType_t ) 0U, &xChange );
+
+												if( ulFactor == tskCRITICALITY_NOT_SCHEDULABLE )
+												{
+														xReturn = pdFAIL;
+												}
+												else
+												{
+														mtCOVERAGE_TEST_MARKER();
+												}
+										}
+										else
+										{
+												mtCOVERAGE_TEST_MARKER();
+										}
+								}
+						#endif /* configUSE_MIXED_CRITICALITY */
+
+						if( xReturn != pdFAIL )
+						{
+								/* Every task switches at its own next job boundary, the tasks
+								 * leaving the mode first, see prvApplyPendingPeriodChange(). */
+								for( x = ( UBaseType_t ) 0U; x < uxNumberOfTasks; x++ )
+								{
+										xDeadline = ( ( pxDeadlines == NULL ) || ( pxDeadlines[ x ] == ( TickType_t ) 0U ) ) ? pxPeriods[ x ] : pxDeadlines[ x ];
+										pxTCB = prvGetTCBFromHandle( pxTasks[ x ] );
+										pxTCB->xTaskPendingPeriod = pxPeriods[ x ];
+										pxTCB->xTaskPendingDeadline = xDeadline;
+										pxTCB->ucPeriodChangePending = pdTRUE;
+								}
+
+								ulTargetDensity = ulNewTargetDensity;
+
+								#if ( configUSE_MIXED_CRITICALITY == 1 )
+										{
+												/* The tasks whose period changes get their new virtual
+												 * deadline when the change is applied. */
+												ulCriticalityFactor = ulFactor;
+
+												for( x = ( UBaseType_t ) 0U; x < uxCriticalityTasks; x++ )
+												{
+														prvCriticalityVirtualDeadline( pxCriticalityTasks[ x ] );
+												}
+										}
+								#endif
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+				taskEXIT_CRITICAL();
+
+				return xReturn;
+		}
+/*-----------------------------------------------------------*/
+
+		BaseType_t xTaskSetPeriod( TaskHandle_t xTask,
+															 TickType_t xNewPeriod,
+															 TickType_t xNewDeadline )
+		{
+				/* Changing one task is a mode change of a single task. */
+				return xTaskSetMode( &xTask, &xNewPeriod, &xNewDeadline, ( UBaseType_t ) 1U );
+		}
+/*-----------------------------------------------------------*/
+
+		#if ( INCLUDE_xTaskDelayUntil == 1 )
+
+				BaseType_t xTaskDelayUntilNextPeriod( TickType_t * const pxPreviousWakeTime )
+				{
+						TickType_t xPeriod;
+
+						/* The calling task has completed its job, this is the job boundary at
+						 * which a requested period/deadline change can take effect. */
+						taskENTER_CRITICAL();
+						{
+								prvApplyPendingPeriodChange( pxCurrentTCB );
+								xPeriod = pxCurrentTCB->xTaskPeriod;
+						}
+						taskEXIT_CRITICAL();
+
+						return xTaskDelayUntil( pxPreviousWakeTime, xPeriod );
+				}
+
+		#endif /* INCLUDE_xTaskDelayUntil */
+/*-----------------------------------------------------------*/
+
+		uint32_t ulTaskGetAdmittedLoad( void )
+		{
+				/* The load (16.16 fixed point) of the task set once every pending change is applied. */
+				return ulTargetDensity;
+		}
+
+#endif /* configUSE_MODE_CHANGE */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_ELASTIC_TASKS == 1 ) )
+
+		BaseType_t xTaskSetElastic( TaskHandle_t xTask,
+																TickType_t xMinPeriod,
+																TickType_t xMaxPeriod,
+																UBaseType_t uxElasticity )
+		{
+				TCB_t * pxTCB;
+				UBaseType_t x;
+				BaseType_t xReturn = pdPASS;
+
+				configASSERT( ( xMinPeriod > ( TickType_t ) 0U ) && ( xMinPeriod <= xMaxPeriod ) );
+				configASSERT( uxElasticity > ( UBaseType_t ) 0U );
+
+				taskENTER_CRITICAL();
+				{
+						/* If xTask is NULL then the calling task is made elastic. */
+						pxTCB = prvGetTCBFromHandle( xTask );
+
+						if( pxTCB->uxElasticity == ( UBaseType_t ) 0U )
+						{
+								if( uxElasticTasks < ( UBaseType_t ) configMAX_ELASTIC_TASKS )
+								{
+										pxElasticTasks[ uxElasticTasks ] = pxTCB;
+										uxElasticTasks++;
+								}
+								else
+								{
+										xReturn = pdFAIL;
+								}
+						}
+						else
+						{
+								/* Already registered, just update its parameters. */
+								mtCOVERAGE_TEST_MARKER();
+						}
+
+						if( xReturn != pdFAIL )
+						{
+								pxTCB->xTaskMinPeriod = xMinPeriod;
+								pxTCB->xTaskMaxPeriod = xMaxPeriod;
+								pxTCB->uxElasticity = uxElasticity;
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+				taskEXIT_CRITICAL();
+
+				return xReturn;
+		}
+/*-----------------------------------------------------------*/
+
+		BaseType_t xTaskElasticAdjust( uint32_t ulLoad )
+		{
+				TaskHandle_t xTasks[ configMAX_ELASTIC_TASKS ];
+				TickType_t xPeriods[ configMAX_ELASTIC_TASKS ];
+				uint32_t ulNominal[ configMAX_ELASTIC_TASKS ]; /* Utilisation at the minimum period. */
+				uint32_t ulMinimum[ configMAX_ELASTIC_TASKS ]; /* Utilisation at the maximum period. */
+				uint32_t ulNew[ configMAX_ELASTIC_TASKS ];
+				BaseType_t xSaturated[ configMAX_ELASTIC_TASKS ];
+				uint32_t ulElasticLoad = 0UL, ulOtherLoad, ulAvailable, ulVariable, ulSaturated, ulExcess, ulElasticitySum;
+				TickType_t xPeriod;
+				TCB_t * pxTCB;
+				UBaseType_t x, uxChanged = ( UBaseType_t ) 0U;
+				BaseType_t xDone, xReturn;
+
+				taskENTER_CRITICAL();
+				{
+						/* ulLoad is the measured or admitted load (16.16 fixed point) of the
+						 * whole task set.  The part of it that is not due to the elastic tasks
+						 * can not be changed, whatever is left below the target is shared by
+						 * the elastic tasks. */
+						for( x = ( UBaseType_t ) 0U; x < uxElasticTasks; x++ )
+						{
+								pxTCB = pxElasticTasks[ x ];
+								xPeriod = ( pxTCB->ucPeriodChangePending != pdFALSE ) ? pxTCB->xTaskPendingPeriod : pxTCB->xTaskPeriod;
+								ulElasticLoad += prvTaskDensity( pxTCB->xTaskWCET, xPeriod, xPeriod );
+								ulNominal[ x ] = prvTaskDensity( pxTCB->xTaskWCET, pxTCB->xTaskMinPeriod, pxTCB->xTaskMinPeriod );
+								ulMinimum[ x ] = prvTaskDensity( pxTCB->xTaskWCET, pxTCB->xTaskMaxPeriod, pxTCB->xTaskMaxPeriod );
+								xSaturated[ x ] = pdFALSE;
+						}
+
+						ulOtherLoad = ( ulLoad > ulElasticLoad ) ? ( ulLoad - ulElasticLoad ) : 0UL;
+						ulAvailable = ( ( uint32_t ) configELASTIC_TARGET_LOAD > ulOtherLoad ) ? ( ( uint32_t ) configELASTIC_TARGET_LOAD - ulOtherLoad ) : 0UL;
+
+						/* Compress the utilisation of each elastic task in proportion to its
+						 * elastic coefficient.  A task that reaches its maximum period can
+						 * not be compressed any further, so the excess is shared again
+						 * between the others until nothing changes. */
+						do
+						{
+								xDone = pdTRUE;
+								ulVariable = 0UL;
+								ulSaturated = 0UL;
+								ulElasticitySum = 0UL;
+
+								for( x = ( UBaseType_t ) 0U; x < uxElasticTasks; x++ )
+								{
+										if( xSaturated[ x ] == pdFALSE )
+										{
+												ulVariable += ulNominal[ x ];
+												ulElasticitySum += ( uint32_t ) pxElasticTasks[ x ]->uxElasticity;
+										}
+										else
+										{
+												ulSaturated += ulMinimum[ x ];
+										}
+								}
+
+								ulExcess = ( ( ulVariable + ulSaturated ) > ulAvailable ) ? ( ( ulVariable + ulSaturated ) - ulAvailable ) : 0UL;
+
+								for( x = ( UBaseType_t ) 0U; x < uxElasticTasks; x++ )
+								{
+										if( xSaturated[ x ] == pdFALSE )
+										{
+												ulNew[ x ] = ulNominal[ x ] - ( ( ulElasticitySum > 0UL ) ? ( ( ulExcess / ulElasticitySum ) * ( uint32_t ) pxElasticTasks[ x ]->uxElasticity ) : 0UL );
+
+												if( ( ulNew[ x ] < ulMinimum[ x ] ) || ( ulNew[ x ] > ulNominal[ x ] ) )
+												{
+														/* Compressed past its maximum period (or wrapped). */
+														ulNew[ x ] = ulMinimum[ x ];
+														xSaturated[ x ] = pdTRUE;
+														xDone = pdFALSE;
+												}
+												else
+												{
+														mtCOVERAGE_TEST_MARKER();
+												}
+										}
+										else
+										{
+												ulNew[ x ] = ulMinimum[ x ];
+										}
+								}
+						} while( xDone == pdFALSE );
+
+						/* Turn the utilisations back into periods, only the tasks whose
+						 * period changes are passed to the mode change. */
+						for( x = ( UBaseType_t ) 0U; x < uxElasticTasks; x++ )
+						{
+								pxTCB = pxElasticTasks[ x ];
+
+								if( ( ulNew[ x ] == 0UL ) || ( ulNew[ x ] >= ulNominal[ x ] ) )
+								{
+										/* No WCET known or no compression needed, run at the nominal rate. */
+										xPeriod = pxTCB->xTaskMinPeriod;
+								}
+								else
+								{
+										xPeriod = ( TickType_t ) ( ( ( uint32_t ) pxTCB->xTaskWCET << tskDENSITY_SHIFT ) / ulNew[ x ] );
+
+										if( xPeriod > pxTCB->xTaskMaxPeriod )
+										{
+												xPeriod = pxTCB->xTaskMaxPeriod;
+										}
+										else if( xPeriod < pxTCB->xTaskMinPeriod )
+										{
+												xPeriod = pxTCB->xTaskMinPeriod;
+										}
+										else
+										{
+												mtCOVERAGE_TEST_MARKER();
+										}
+								}
+
+								if( xPeriod != ( ( pxTCB->ucPeriodChangePending != pdFALSE ) ? pxTCB->xTaskPendingPeriod : pxTCB->xTaskPeriod ) )
+								{
+										xTasks[ uxChanged ] = pxTCB;
+										xPeriods[ uxChanged ] = xPeriod;
+										uxChanged++;
+								}
+								else
+								{
+										mtCOVERAGE_TEST_MARKER();
+								}
+						}
+				}
+				taskEXIT_CRITICAL();
+
+				/* The new periods go through the mode change protocol, so each elastic
+				 * task switches at its own job boundary and no job loses its deadline.
+				 * The periods of elastic tasks that have a criticality are also tested
+				 * against EDF-VD there, if that fails no period changes. */
+				if( uxChanged > ( UBaseType_t ) 0U )
+				{
+						xReturn = xTaskSetMode( xTasks, xPeriods, NULL, uxChanged );
+				}
+				else
+				{
+						xReturn = pdPASS;
+				}
+
+				return xReturn;
+		}
+
+#endif /* configUSE_ELASTIC_TASKS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( ( configUSE_MK_FIRM == 1 ) || ( configUSE_ABORT_ON_MISS == 1 ) ) )
+
+		static void prvDelayTaskUntilRelease( TCB_t * pxTCB,
+																					TickType_t xReleaseTime )
+		{
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), xReleaseTime );
+
+				if( xReleaseTime < xTickCount )
+				{
+						/* Wake time has overflowed.  Place this item in the overflow list. */
+						vListInsert( pxOverflowDelayedTaskList, &( pxTCB->xStateListItem ) );
+				}
+				else
+				{
+						vListInsert( pxDelayedTaskList, &( pxTCB->xStateListItem ) );
+
+						if( xReleaseTime < xNextTaskUnblockTime )
+						{
+								xNextTaskUnblockTime = xReleaseTime;
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+		}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_MK_FIRM == 1 ) )
+
+		static void prvMKRecordOutcome( TCB_t * pxTCB,
+																		BaseType_t xDeadlineMet )
+		{
+				if( pxTCB->uxMKWindow > ( UBaseType_t ) 0U )
+				{
+						pxTCB->ulMKHistory = ( pxTCB->ulMKHistory << 1 ) | ( ( xDeadlineMet != pdFALSE ) ? 1UL : 0UL );
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+		}
+/*-----------------------------------------------------------*/
+
+		static UBaseType_t prvMKDistanceToFailure( const TCB_t * pxTCB )
+		{
+				UBaseType_t uxDistance, uxMet, x;
+				uint32_t ulHistory;
+
+				/* After n more lost jobs the window holds those n jobs and the last
+				 * (k - n) outcomes, so the constraint still holds while those outcomes
+				 * contain at least m met deadlines. */
+				for( uxDistance = ( UBaseType_t ) 0U; uxDistance < pxTCB->uxMKWindow; uxDistance++ )
+				{
+						uxMet = ( UBaseType_t ) 0U;
+						ulHistory = pxTCB->ulMKHistory;
+
+						for( x = ( UBaseType_t ) 0U; x < ( pxTCB->uxMKWindow - uxDistance - ( UBaseType_t ) 1U ); x++ )
+						{
+								uxMet += ( UBaseType_t ) ( ulHistory & 1UL );
+								ulHistory >>= 1;
+						}
+
+						if( uxMet < pxTCB->uxMKMeet )
+						{
+								break;
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+
+				return uxDistance;
+		}
+/*-----------------------------------------------------------*/
+
+		static void prvMKShedLoad( const TCB_t * pxReleasedTCB )
+		{
+				const List_t * pxList;
+				const ListItem_t * pxEndMarker;
+				ListItem_t * pxIterator;
+				TCB_t * pxTCB;
+				TCB_t * pxSkipTCB = NULL;
+				TickType_t xDemand = ( TickType_t ) 0U, xNextRelease;
+				const BaseType_t xTimeLeft = ( BaseType_t ) ( pxReleasedTCB->xTaskAbsoluteDeadline - xTickCount );
+				UBaseType_t uxDistance, uxSkipDistance = ( UBaseType_t ) 0U;
+				UBaseType_t uxList;
+
+				/* The released job can not meet its deadline if the work left in the
+				 * jobs due no later than it is more than the time left until that
+				 * deadline.  The same walk finds the job that has not started yet and
+				 * is the furthest from breaking its (m,k) constraint.  The deadlines
+				 * are compared as signed differences so the walk holds across a tick
+				 * count wrap. */
+				for( uxList = ( UBaseType_t ) 0U; uxList < tskEDF_READY_LISTS; uxList++ )
+				{
+						pxList = taskEDF_READY_LIST( uxList );
+						pxEndMarker = listGET_END_MARKER( pxList );
+
+						for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+						{
+								pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+								if( ( pxTCB != xIdleTaskHandle ) && ( ( BaseType_t ) ( pxTCB->xTaskAbsoluteDeadline - pxReleasedTCB->xTaskAbsoluteDeadline ) <= 0 ) )
+								{
+										xDemand += pxTCB->xTaskRemainingExecution;
+
+										if( ( pxTCB != pxCurrentTCB ) &&
+												( pxTCB->ucJobStarted == pdFALSE ) &&
+												( pxTCB->ucMKWaiting != pdFALSE ) &&
+												( pxTCB->uxMKWindow > ( UBaseType_t ) 0U ) )
+										{
+												uxDistance = prvMKDistanceToFailure( pxTCB );
+
+												/* On a tie the later job wins, the lists are not walked in
+												 * deadline order when EDF buckets are used. */
+												if( ( uxDistance > ( UBaseType_t ) 0U ) &&
+														( ( uxDistance > uxSkipDistance ) ||
+															( ( uxDistance == uxSkipDistance ) && ( ( BaseType_t ) ( pxTCB->xTaskAbsoluteDeadline - pxSkipTCB->xTaskAbsoluteDeadline ) >= 0 ) ) ) )
+												{
+														pxSkipTCB = pxTCB;
+														uxSkipDistance = uxDistance;
+												}
+												else
+												{
+														mtCOVERAGE_TEST_MARKER();
+												}
+										}
+										else
+										{
+												mtCOVERAGE_TEST_MARKER();
+										}
+								}
+								else
+								{
+										mtCOVERAGE_TEST_MARKER();
+								}
+						}
+				}
+
+				/* A released job whose deadline has already passed can not meet it
+				 * whatever the demand. */
+				if( ( ( xTimeLeft <= 0 ) || ( xDemand > ( TickType_t ) xTimeLeft ) ) && ( pxSkipTCB != NULL ) )
+				{
+						/* Skip the job.  The task goes back to the delayed list until its
+						 * next release.  The wake time it passed to xTaskDelayUntil() is on
+						 * its own stack, the task moves it on itself when it returns. */
+						prvMKRecordOutcome( pxSkipTCB, pdFALSE );
+						( pxSkipTCB->uxSkippedJobs )++;
+
+						xNextRelease = ( pxSkipTCB->xTaskAbsoluteDeadline - pxSkipTCB->xTaskRelativeDeadline ) + pxSkipTCB->xTaskPeriod;
+						pxSkipTCB->xMKSkippedWakeTime = xNextRelease;
+						pxSkipTCB->ucMKSkipped = pdTRUE;
+						prvDelayTaskUntilRelease( pxSkipTCB, xNextRelease );
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+		}
+/*-----------------------------------------------------------*/
+
+		BaseType_t xTaskSetMKFirm( TaskHandle_t xTask,
+															 UBaseType_t uxMeet,
+															 UBaseType_t uxWindow )
+		{
+				TCB_t * pxTCB;
+				BaseType_t xReturn;
+
+				/* A window of 0 turns the constraint off for the task. */
+				if( ( uxWindow <= ( UBaseType_t ) 32U ) && ( uxMeet <= uxWindow ) )
+				{
+						taskENTER_CRITICAL();
+						{
+								/* If xTask is NULL then set the calling task's constraint. */
+								pxTCB = prvGetTCBFromHandle( xTask );
+
+								/* Start as if every earlier job met its deadline. */
+								pxTCB->uxMKMeet = uxMeet;
+								pxTCB->uxMKWindow = uxWindow;
+								pxTCB->ulMKHistory = 0xffffffffUL;
+						}
+						taskEXIT_CRITICAL();
+
+						xReturn = pdPASS;
+				}
+				else
+				{
+						xReturn = pdFAIL;
+				}
+
+				return xReturn;
+		}
+/*-----------------------------------------------------------*/
+
+		UBaseType_t uxTaskGetSkippedJobCount( TaskHandle_t xTask )
+		{
+				TCB_t * pxTCB;
+
+				/* If xTask is NULL then get the calling task's skipped jobs. */
+				pxTCB = prvGetTCBFromHandle( xTask );
+
+				return pxTCB->uxSkippedJobs;
+		}
+
+#endif /* configUSE_MK_FIRM */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_ABORT_ON_MISS == 1 ) )
+
+		static BaseType_t prvAbortMissedJob( TCB_t * pxTCB )
+		{
+				TickType_t xNextRelease;
+				BaseType_t xReturn = pdFALSE;
+
+				#if ( configUSE_HIGH_RESOLUTION_RELEASES == 1 )
+						uint32_t ulRemaining;
+				#endif
+
+				if( ( pxTCB->ucAbortOnMiss != pdFALSE ) &&
+						( pxTCB->ucMissLatched == pdFALSE ) &&
+						( ( BaseType_t ) ( xTickCount - pxTCB->xTaskAbsoluteDeadline ) > 0 ) &&
+						( taskIS_READY_EDF( pxTCB ) != pdFALSE ) )
+				{
+						#if ( configUSE_MUTEXES == 1 )
+								if( pxTCB->uxMutexesHeld != ( UBaseType_t ) 0U )
+								{
+										/* Throwing the stack away would leave the mutexes the task
+										 * holds locked, so the job is left to complete.  The miss is
+										 * latched so it is not raised again every tick until the next
+										 * release. */
+										pxTCB->ucMissLatched = pdTRUE;
+								}
+								else
+						#endif
+						{
+								/* The aborted job was released one relative deadline before
+								 * its deadline.  Read before a pending period change is
+								 * applied below. */
+								xNextRelease = pxTCB->xTaskAbsoluteDeadline - pxTCB->xTaskRelativeDeadline;
+
+								if( pxTCB->pxRecoveryHook != NULL )
+								{
+										( void ) pxTCB->pxRecoveryHook( ( void * ) pxTCB );
+								}
+								else
+								{
+										mtCOVERAGE_TEST_MARKER();
+								}
+
+								/* Build the initial context again so the task restarts at its
+								 * entry point the next time it runs. */
+								#if ( portHAS_STACK_OVERFLOW_CHECKING == 1 )
+										{
+												#if ( portSTACK_GROWTH < 0 )
+														{
+																pxTCB->pxTopOfStack = pxPortInitialiseStack( pxTCB->pxInitialTopOfStack, pxTCB->pxStack, pxTCB->pxTaskCode, pxTCB->pvParameters );
+														}
+												#else /* portSTACK_GROWTH */
+														{
+																pxTCB->pxTopOfStack = pxPortInitialiseStack( pxTCB->pxInitialTopOfStack, pxTCB->pxEndOfStack, pxTCB->pxTaskCode, pxTCB->pvParameters );
+														}
+												#endif /* portSTACK_GROWTH */
+										}
+								#else /* portHAS_STACK_OVERFLOW_CHECKING */
+										{
+												pxTCB->pxTopOfStack = pxPortInitialiseStack( pxTCB->pxInitialTopOfStack, pxTCB->pxTaskCode, pxTCB->pvParameters );
+										}
+								#endif /* portHAS_STACK_OVERFLOW_CHECKING */
+
+								#if ( configUSE_SCHEDULER_STATS == 1 )
+										{
+												( pxTCB->uxDeadlineMisses )++;
+										}
+								#endif
+
+								#if ( configUSE_MK_FIRM == 1 )
+										{
+												/* The task restarts at its entry point, nothing waits for a
+												 * skipped release any more. */
+												prvMKRecordOutcome( pxTCB, pdFALSE );
+												pxTCB->ucMKWaiting = pdFALSE;
+												pxTCB->ucMKSkipped = pdFALSE;
+										}
+								#endif
+
+								#if ( configUSE_LIMITED_PREEMPTION == 1 )
+										{
+												/* The non-preemptive regions of the job end with it. */
+												pxTCB->uxNPRNesting = ( UBaseType_t ) 0U;
+												xPreemptionDeferred = pdFALSE;
+										}
+								#endif
+
+								#if ( configUSE_BLOCKING_PROFILER == 1 )
+										{
+												/* Nor is the task inside a critical section any more. */
+												pxTCB->uxBlockingDepth = ( UBaseType_t ) 0U;
+												pxTCB->ulBlockingSite = 0UL;
+										}
+								#endif
+
+								#if ( configUSE_MODE_CHANGE == 1 )
+										{
+												/* The abort is a job boundary too. */
+												prvApplyPendingPeriodChange( pxTCB );
+										}
+								#endif
+
+								#if ( configUSE_HIGH_RESOLUTION_RELEASES == 1 )
+										if( pxTCB->ulHRPeriod > 0UL )
+										{
+												/* The next release is on the grid of the timer, as in
+												 * vTaskDelayUntilNextRelease(). */
+												pxTCB->ulHRRelease += pxTCB->ulHRPeriod;
+												ulRemaining = pxTCB->ulHRRelease - configHR_TIMER_COUNT();
+
+												if( ( int32_t ) ulRemaining > 0 )
+												{
+														pxTCB->ucHRWaiting = pdTRUE;
+														prvDelayTaskUntilRelease( pxTCB, xTickCount + tskHR_COUNTS_TO_TICKS( ulRemaining ) + ( TickType_t ) 1 );
+												}
+												else
+												{
+														( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+														taskPOLICY_RELEASE( pxTCB, tskHR_RELEASE_TICK( ( uint32_t ) 0UL - ulRemaining ) );
+														prvAddTaskToReadyList( pxTCB );
+												}
+
+												/* Program the compare match for the new release.  The caller
+												 * selects the next task, so what it releases is picked up. */
+												( void ) prvHRReleaseDueTasks();
+										}
+										else
+								#endif /* configUSE_HIGH_RESOLUTION_RELEASES */
+								{
+										/* The next job is released one period after the aborted one,
+										 * keeping the phase of the task.  If that is already due the
+										 * job is released late at the time it was due, and aborted in
+										 * turn if its deadline has passed too. */
+										xNextRelease += pxTCB->xTaskPeriod;
+
+										if( ( BaseType_t ) ( xNextRelease - xTickCount ) > 0 )
+										{
+												prvDelayTaskUntilRelease( pxTCB, xNextRelease );
+										}
+										else
+										{
+												( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+												taskPOLICY_RELEASE( pxTCB, xNextRelease );
+												prvAddTaskToReadyList( pxTCB );
+										}
+								}
+
+								( pxTCB->uxAbortedJobs )++;
+
+								xReturn = pdTRUE;
+						}
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				return xReturn;
+		}
+/*-----------------------------------------------------------*/
+
+		BaseType_t xTaskSetAbortOnMiss( TaskHandle_t xTask,
+																		BaseType_t xAbortOnMiss,
+																		TaskHookFunction_t pxRecoveryHook )
+		{
+				TCB_t * pxTCB;
+
+				taskENTER_CRITICAL();
+				{
+						/* If xTask is NULL then set the calling task's mode. */
+						pxTCB = prvGetTCBFromHandle( xTask );
+
+						pxTCB->ucAbortOnMiss = ( uint8_t ) ( ( xAbortOnMiss != pdFALSE ) ? pdTRUE : pdFALSE );
+						pxTCB->pxRecoveryHook = pxRecoveryHook;
+				}
+				taskEXIT_CRITICAL();
+
+				return pdPASS;
+		}
+/*-----------------------------------------------------------*/
+
+		UBaseType_t uxTaskGetAbortedJobCount( TaskHandle_t xTask )
+		{
+				TCB_t * pxTCB;
+
+				/* If xTask is NULL then get the calling task's aborted jobs. */
+				pxTCB = prvGetTCBFromHandle( xTask );
+
+				return pxTCB->uxAbortedJobs;
+		}
+
+#endif /* configUSE_ABORT_ON_MISS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_RUN_TO_COMPLETION_JOBS == 1 ) )
+
+		static portTASK_FUNCTION( prvJobDispatcherTask, pvParameters )
+		{
+				JCB_t * pxJob;
+				ListItem_t * pxIterator;
+				TickType_t xTicksToRelease, xRelativeDeadline;
+				BaseType_t xAlreadyYielded, xYieldRequired;
+
+				/* Stop warnings. */
+				( void ) pvParameters;
+
+				for( ; ; )
+				{
+						xYieldRequired = pdFALSE;
+
+						taskENTER_CRITICAL();
+						{
+								/* Move the jobs released since the last pass to the ready list, in
+								 * the waiting list the item value of a job is its release time.
+								 * The list is sorted on the raw value, so once the tick count wraps
+								 * a later release can sort ahead of an earlier one.  It only holds
+								 * a few jobs, all of them are checked. */
+								pxIterator = listGET_HEAD_ENTRY( &xJobsWaitingList );
+
+								while( pxIterator != listGET_END_MARKER( &xJobsWaitingList ) )
+								{
+										pxJob = ( JCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+										pxIterator = listGET_NEXT( pxIterator );
+
+										if( ( BaseType_t ) ( listGET_LIST_ITEM_VALUE( &( pxJob->xJobListItem ) ) - xTickCount ) <= 0 )
+										{
+												( void ) uxListRemove( &( pxJob->xJobListItem ) );
+												pxJob->xJobAbsoluteDeadline = pxJob->xJobReleaseTime + pxJob->xJobRelativeDeadline;
+												listSET_LIST_ITEM_VALUE( &( pxJob->xJobListItem ), pxJob->xJobAbsoluteDeadline );
+												vListInsert( &xJobsReadyList, &( pxJob->xJobListItem ) );
+										}
+										else
+										{
+												mtCOVERAGE_TEST_MARKER();
+										}
+								}
+
+								if( listLIST_IS_EMPTY( &xJobsReadyList ) == pdFALSE )
+								{
+										pxJob = ( JCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xJobsReadyList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+										( void ) uxListRemove( &( pxJob->xJobListItem ) );
+
+										/* The dispatcher competes with the other tasks as the job it is
+										 * about to run.  Move it to its place in the ready list and give
+										 * way if that is not the head. */
+										( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+										pxCurrentTCB->xTaskPeriod = pxJob->xJobPeriod;
+										pxCurrentTCB->xTaskRelativeDeadline = pxJob->xJobRelativeDeadline;
+										pxCurrentTCB->xTaskAbsoluteDeadline = pxJob->xJobAbsoluteDeadline;
+										listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), ( TickType_t ) taskPOLICY_KEY( pxCurrentTCB ) );
+										prvAddTaskToReadyList( pxCurrentTCB );
+
+										if( taskREADY_SET_HEAD() != pxCurrentTCB )
+										{
+												xYieldRequired = pdTRUE;
+										}
+										else
+										{
+												mtCOVERAGE_TEST_MARKER();
+										}
+								}
+								else
+								{
+										pxJob = NULL;
+								}
+						}
+						taskEXIT_CRITICAL();
+
+						if( xYieldRequired != pdFALSE )
+						{
+								taskYIELD_IF_USING_PREEMPTION();
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+
+						if( pxJob != NULL )
+						{
+								/* Switching to the job is a function call on the dispatcher's
+								 * stack, which all the jobs share.  Jobs never interleave, one
+								 * released while another runs waits for it to return. */
+								pxJob->pxJobCode( pxJob->pvParameters );
+
+								taskENTER_CRITICAL();
+								{
+										if( listLIST_ITEM_CONTAINER( &( pxJob->xJobListItem ) ) != NULL )
+										{
+												/* The job restarted itself, or was restarted while it ran. */
+												mtCOVERAGE_TEST_MARKER();
+										}
+										else if( ( pxJob->ucJobActive != pdFALSE ) && ( pxJob->ucJobAutoReload != pdFALSE ) )
+										{
+												/* The next release is one period after the last one. */
+												pxJob->xJobReleaseTime += pxJob->xJobPeriod;
+												listSET_LIST_ITEM_VALUE( &( pxJob->xJobListItem ), pxJob->xJobReleaseTime );
+												vListInsert( &xJobsWaitingList, &( pxJob->xJobListItem ) );
+										}
+										else
+										{
+												/* A one-shot timer has run, or the timer was stopped while
+												 * it ran. */
+												pxJob->ucJobActive = pdFALSE;
+										}
+								}
+								taskEXIT_CRITICAL();
+						}
+						else
+						{
+								vTaskSuspendAll();
+								{
+										/* Nothing is ready, block until the next release.  The tick
+										 * releases the dispatcher with the relative deadline set here,
+										 * which is the shortest relative deadline of the jobs released
+										 * then.  The time to each release is taken as a difference so
+										 * it holds across a tick count wrap. */
+										xTicksToRelease = portMAX_DELAY;
+										xRelativeDeadline = portMAX_DELAY;
+
+										for( pxIterator = listGET_HEAD_ENTRY( &xJobsWaitingList );
+												 pxIterator != listGET_END_MARKER( &xJobsWaitingList );
+												 pxIterator = listGET_NEXT( pxIterator ) )
+										{
+												pxJob = ( JCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+												if( ( BaseType_t ) ( listGET_LIST_ITEM_VALUE( pxIterator ) - xTickCount ) <= 0 )
+												{
+														xTicksToRelease = ( TickType_t ) 0U;
+												}
+												else if( ( TickType_t ) ( listGET_LIST_ITEM_VALUE( pxIterator ) - xTickCount ) < xTicksToRelease )
+												{
+														xTicksToRelease = listGET_LIST_ITEM_VALUE( pxIterator ) - xTickCount;
+														xRelativeDeadline = pxJob->xJobRelativeDeadline;
+												}
+												else if( ( ( TickType_t ) ( listGET_LIST_ITEM_VALUE( pxIterator ) - xTickCount ) == xTicksToRelease ) &&
+																 ( pxJob->xJobRelativeDeadline < xRelativeDeadline ) )
+												{
+														xRelativeDeadline = pxJob->xJobRelativeDeadline;
+												}
+												else
+												{
+														mtCOVERAGE_TEST_MARKER();
+												}
+										}
+
+										if( listLIST_IS_EMPTY( &xJobsWaitingList ) != pdFALSE )
+										{
+												/* Only stopped timers, wait until one is started. */
+												prvAddCurrentTaskToDelayedList( portMAX_DELAY, pdTRUE );
+										}
+										else if( xTicksToRelease > ( TickType_t ) 0U )
+										{
+												pxCurrentTCB->xTaskPeriod = xRelativeDeadline;
+												pxCurrentTCB->xTaskRelativeDeadline = xRelativeDeadline;
+												prvAddCurrentTaskToDelayedList( xTicksToRelease, pdFALSE );
+										}
+										else
+										{
+												/* A job was released in the meantime, go round again. */
+												mtCOVERAGE_TEST_MARKER();
+										}
+								}
+								xAlreadyYielded = xTaskResumeAll();
+
+								if( xAlreadyYielded == pdFALSE )
+								{
+										portYIELD_WITHIN_API();
+								}
+								else
+								{
+										mtCOVERAGE_TEST_MARKER();
+								}
+						}
+				}
+		}
+/*-----------------------------------------------------------*/
+
+		static JCB_t * prvJobCreate( TaskFunction_t pxJobCode,
+																 void * const pvParameters,
+																 TickType_t xJobPeriod,
+																 TickType_t xJobRelativeDeadline,
+																 BaseType_t xAutoReload )
+		{
+				JCB_t * pxNewJob = NULL;
+				BaseType_t xReturn = pdPASS;
+
+				/* The first job creates the task that runs all the jobs on its stack. */
+				if( xJobDispatcherHandle == NULL )
+				{
+						vListInitialise( &xJobsWaitingList );
+						vListInitialise( &xJobsReadyList );
+						xReturn = xTaskPeriodicCreate( prvJobDispatcherTask,
+																					 configJOB_DISPATCHER_NAME,
+																					 configJOB_DISPATCHER_STACK_SIZE,
+																					 NULL,
+																					 tskIDLE_PRIORITY,
+																					 xJobRelativeDeadline,
+																					 &xJobDispatcherHandle );
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( xReturn == pdPASS )
+				{
+						pxNewJob = ( JCB_t * ) pvPortMalloc( sizeof( JCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack. */
+
+						if( pxNewJob != NULL )
+						{
+								pxNewJob->pxJobCode = pxJobCode;
+								pxNewJob->pvParameters = pvParameters;
+								pxNewJob->xJobPeriod = xJobPeriod;
+								pxNewJob->xJobRelativeDeadline = xJobRelativeDeadline;
+								pxNewJob->ucJobAutoReload = ( uint8_t ) ( ( xAutoReload != pdFALSE ) ? pdTRUE : pdFALSE );
+								pxNewJob->ucJobActive = pdFALSE;
+								vListInitialiseItem( &( pxNewJob->xJobListItem ) );
+								listSET_LIST_ITEM_OWNER( &( pxNewJob->xJobListItem ), pxNewJob );
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				return pxNewJob;
+		}
+/*-----------------------------------------------------------*/
+
+		BaseType_t xTaskPeriodicJobCreate( TaskFunction_t pxJobCode,
+																			 void * const pvParameters,
+																			 TickType_t xJobPeriod )
+		{
+				JCB_t * pxNewJob;
+				BaseType_t xReturn;
+
+				configASSERT( pxJobCode );
+				configASSERT( xJobPeriod > ( TickType_t ) 0U );
+
+				/* Deadlines of periodic jobs are implicit. */
+				pxNewJob = prvJobCreate( pxJobCode, pvParameters, xJobPeriod, xJobPeriod, pdTRUE );
+
+				if( pxNewJob != NULL )
+				{
+						/* The first job is released now.  A job created after the
+						 * scheduler has started is picked up the next time the
+						 * dispatcher runs. */
+						taskENTER_CRITICAL();
+						{
+								pxNewJob->ucJobActive = pdTRUE;
+								pxNewJob->xJobReleaseTime = xTickCount;
+								listSET_LIST_ITEM_VALUE( &( pxNewJob->xJobListItem ), xTickCount );
+								vListInsert( &xJobsWaitingList, &( pxNewJob->xJobListItem ) );
+						}
+						taskEXIT_CRITICAL();
+
+						xReturn = pdPASS;
+				}
+				else
+				{
+						xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+				}
+
+				return xReturn;
+		}
+
+#endif /* configUSE_RUN_TO_COMPLETION_JOBS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_DEADLINE_TIMERS == 1 ) )
+
+		static BaseType_t prvJobDispatcherWake( void )
+		{
+				TCB_t * const pxTCB = xJobDispatcherHandle;
+				BaseType_t xYieldRequired = pdFALSE;
+
+				if( ( pxTCB != pxCurrentTCB ) &&
+						( taskIS_READY_EDF( pxTCB ) == pdFALSE ) )
+				{
+						/* The dispatcher is in the delayed or suspended list.  Release it
+						 * so it goes round again and blocks until the earliest release. */
+						( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+						taskPOLICY_RELEASE( pxTCB, xTickCount );
+						prvAddTaskToReadyList( pxTCB );
+
+						if( taskPOLICY_SHOULD_PREEMPT( pxTCB ) != pdFALSE )
+						{
+								xYieldRequired = pdTRUE;
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				return xYieldRequired;
+		}
+/*-----------------------------------------------------------*/
+
+		JobHandle_t xTaskDeadlineTimerCreate( TaskFunction_t pxCallback,
+																					void * const pvParameters,
+																					TickType_t xPeriod,
+																					TickType_t xRelativeDeadline,
+																					BaseType_t xAutoReload )
+		{
+				configASSERT( pxCallback );
+				configASSERT( xPeriod > ( TickType_t ) 0U );
+
+				/* A deadline of 0 means the deadline is equal to the period. */
+				if( xRelativeDeadline == ( TickType_t ) 0U )
+				{
+						xRelativeDeadline = xPeriod;
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* The timer is created stopped. */
+				return ( JobHandle_t ) prvJobCreate( pxCallback, pvParameters, xPeriod, xRelativeDeadline, xAutoReload );
+		}
+/*-----------------------------------------------------------*/
+
+		BaseType_t xTaskDeadlineTimerStart( JobHandle_t xTimer )
+		{
+				JCB_t * const pxJob = ( JCB_t * ) xTimer;
+				BaseType_t xYieldRequired = pdFALSE;
+
+				configASSERT( pxJob );
+
+				taskENTER_CRITICAL();
+				{
+						/* Starting a timer that is already running restarts it. */
+						if( listLIST_ITEM_CONTAINER( &( pxJob->xJobListItem ) ) != NULL )
+						{
+								( void ) uxListRemove( &( pxJob->xJobListItem ) );
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+
+						/* The callback is released one period from now and must complete
+						 * within its relative deadline of the release. */
+						pxJob->ucJobActive = pdTRUE;
+						pxJob->xJobReleaseTime = xTickCount + pxJob->xJobPeriod;
+						listSET_LIST_ITEM_VALUE( &( pxJob->xJobListItem ), pxJob->xJobReleaseTime );
+						vListInsert( &xJobsWaitingList, &( pxJob->xJobListItem ) );
+
+						if( xSchedulerRunning != pdFALSE )
+						{
+								xYieldRequired = prvJobDispatcherWake();
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+				taskEXIT_CRITICAL();
+
+				/* Give way to the dispatcher outside the critical section. */
+				if( xYieldRequired != pdFALSE )
+				{
+						taskYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				return pdPASS;
+		}
+/*-----------------------------------------------------------*/
+
+		BaseType_t xTaskDeadlineTimerStop( JobHandle_t xTimer )
+		{
+				JCB_t * const pxJob = ( JCB_t * ) xTimer;
+
+				configASSERT( pxJob );
+
+				taskENTER_CRITICAL();
+				{
+						/* A callback that is running completes, it is just not released
+						 * again. */
+						if( listLIST_ITEM_CONTAINER( &( pxJob->xJobListItem ) ) != NULL )
+						{
+								( void ) uxListRemove( &( pxJob->xJobListItem ) );
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+
+						pxJob->ucJobActive = pdFALSE;
+				}
+				taskEXIT_CRITICAL();
+
+				return pdPASS;
+		}
+/*-----------------------------------------------------------*/
+
+		BaseType_t xTaskDeadlineTimerIsActive( JobHandle_t xTimer )
+		{
+				JCB_t * const pxJob = ( JCB_t * ) xTimer;
+				BaseType_t xReturn;
+
+				configASSERT( pxJob );
+
+				taskENTER_CRITICAL();
+				{
+						xReturn = ( pxJob->ucJobActive != pdFALSE ) ? pdTRUE : pdFALSE;
+				}
+				taskEXIT_CRITICAL();
+
+				return xReturn;
+		}
+
+#endif /* configUSE_DEADLINE_TIMERS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_LIMITED_PREEMPTION == 1 ) )
+
+		static BaseType_t prvLimitedPreemptionCheck( const TCB_t * pxTCB )
+		{
+				const TickType_t xKey = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+				const TickType_t xCurrentKey = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ) );
+				BaseType_t xReturn = pdFALSE;
+
+				/* The running job is only preempted by a job whose key is lower than its
+				 * own by more than its preemption threshold.  The keys are compared the
+				 * way the ready list sorts them, and the gap is taken as a difference
+				 * of the two as adding the threshold to a key could wrap. */
+				if( ( xKey < xCurrentKey ) && ( ( TickType_t ) ( xCurrentKey - xKey ) > pxCurrentTCB->xPreemptionThreshold ) )
+				{
+						if( ( pxCurrentTCB->uxNPRNesting > ( UBaseType_t ) 0U ) &&
+								( ( TickType_t ) ( xTickCount - pxCurrentTCB->xNPRStartTime ) < pxCurrentTCB->xMaxNPRLength ) )
+						{
+								/* Inside a non-preemptive region, the switch happens when the
+								 * region ends or runs out of its length. */
+								xPreemptionDeferred = pdTRUE;
+						}
+						else
+						{
+								xReturn = pdTRUE;
+						}
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				return xReturn;
+		}
+/*-----------------------------------------------------------*/
+
+		void vTaskEnterNonPreemptiveRegion( void )
+		{
+				taskENTER_CRITICAL();
+				{
+						if( pxCurrentTCB->uxNPRNesting == ( UBaseType_t ) 0U )
+						{
+								pxCurrentTCB->xNPRStartTime = xTickCount;
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+
+						( pxCurrentTCB->uxNPRNesting )++;
+				}
+				taskEXIT_CRITICAL();
+		}
+/*-----------------------------------------------------------*/
+
+		void vTaskExitNonPreemptiveRegion( void )
+		{
+				BaseType_t xYieldRequired = pdFALSE;
+
+				taskENTER_CRITICAL();
+				{
+						configASSERT( pxCurrentTCB->uxNPRNesting > ( UBaseType_t ) 0U );
+
+						( pxCurrentTCB->uxNPRNesting )--;
+
+						/* Give way now to the job that was held off by the region. */
+						if( ( pxCurrentTCB->uxNPRNesting == ( UBaseType_t ) 0U ) && ( xPreemptionDeferred != pdFALSE ) )
+						{
+								xYieldRequired = pdTRUE;
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+				taskEXIT_CRITICAL();
+
+				if( xYieldRequired != pdFALSE )
+				{
+						taskYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+		}
+/*-----------------------------------------------------------*/
+
+		void vTaskSetPreemptionLimits( TaskHandle_t xTask,
+																	 TickType_t xMaxNPRLength,
+																	 TickType_t xPreemptionThreshold )
+		{
+				TCB_t * pxTCB;
+
+				taskENTER_CRITICAL();
+				{
+						/* If xTask is NULL then set the calling task's limits. */
+						pxTCB = prvGetTCBFromHandle( xTask );
+
+						pxTCB->xMaxNPRLength = xMaxNPRLength;
+						pxTCB->xPreemptionThreshold = xPreemptionThreshold;
+				}
+				taskEXIT_CRITICAL();
+		}
+
+#endif /* configUSE_LIMITED_PREEMPTION */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_HIGH_RESOLUTION_RELEASES == 1 ) )
+
+		BaseType_t xTaskSetHighResolutionPeriod( TaskHandle_t xTask,
+																						 uint32_t ulPeriod,
+																						 uint32_t ulDeadline )
+		{
+				TCB_t * pxTCB;
+				BaseType_t xReturn = pdPASS;
+
+				configASSERT( ulPeriod > 0UL );
+
+				/* A deadline of 0 means the deadline is equal to the period. */
+				if( ulDeadline == 0UL )
+				{
+						ulDeadline = ulPeriod;
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				taskENTER_CRITICAL();
+				{
+						/* If xTask is NULL then the calling task is given the period. */
+						pxTCB = prvGetTCBFromHandle( xTask );
+
+						if( pxTCB->ulHRPeriod == 0UL )
+						{
+								if( uxHRTasks < ( UBaseType_t ) configMAX_HR_TASKS )
+								{
+										pxHRTasks[ uxHRTasks ] = pxTCB;
+										uxHRTasks++;
+								}
+								else
+								{
+										xReturn = pdFAIL;
+								}
+						}
+						else
+						{
+								/* Already registered, just update its parameters. */
+								mtCOVERAGE_TEST_MARKER();
+						}
+
+						if( xReturn != pdFAIL )
+						{
+								#if ( configUSE_MODE_CHANGE == 1 )
+										{
+												ulTargetDensity -= prvTaskTargetDensity( pxTCB );
+												ulCommittedDensity -= pxTCB->ulTaskDensity;
+										}
+								#endif
+
+								/* The ready list is still sorted in ticks, so the policies see
+								 * the period and deadline rounded up to whole ticks. */
+								pxTCB->ulHRPeriod = ulPeriod;
+								pxTCB->ulHRDeadline = ulDeadline;
+								pxTCB->xTaskPeriod = tskHR_COUNTS_TO_TICKS( ulPeriod );
+								pxTCB->xTaskRelativeDeadline = tskHR_COUNTS_TO_TICKS( ulDeadline );
+
+								#if ( configUSE_MODE_CHANGE == 1 )
+										{
+												pxTCB->ulTaskDensity = prvTaskDensity( pxTCB->xTaskWCET, pxTCB->xTaskPeriod, pxTCB->xTaskRelativeDeadline );
+												ulCommittedDensity += pxTCB->ulTaskDensity;
+												ulTargetDensity += prvTaskTargetDensity( pxTCB );
+										}
+								#endif
+
+								/* The current job counts as released now. */
+								pxTCB->ulHRRelease = configHR_TIMER_COUNT();
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+				taskEXIT_CRITICAL();
+
+				return xReturn;
+		}
+/*-----------------------------------------------------------*/
+
+		void vTaskDelayUntilNextRelease( void )
+		{
+				uint32_t ulNow, ulRemaining;
+				BaseType_t xAlreadyYielded;
+
+				configASSERT( pxCurrentTCB->ulHRPeriod > 0UL );
+				configASSERT( uxSchedulerSuspended == 0 );
+
+				vTaskSuspendAll();
+				{
+						/* The compare interrupt reads the release times, so they are only
+						 * changed with interrupts masked. */
+						taskENTER_CRITICAL();
+						{
+								ulNow = configHR_TIMER_COUNT();
+
+								#if ( configUSE_SCHEDULER_STATS == 1 )
+										{
+												/* Calling this function ends the current job, so check it
+												 * against its deadline in timer counts. */
+												if( ( int32_t ) ( ulNow - ( pxCurrentTCB->ulHRRelease + pxCurrentTCB->ulHRDeadline ) ) > 0 )
+												{
+														( pxCurrentTCB->uxDeadlineMisses )++;
+												}
+												else
+												{
+														mtCOVERAGE_TEST_MARKER();
+												}
+										}
+								#endif
+
+								/* Releases stay on the grid of the first release, the differences
+								 * are signed so the counter can wrap. */
+								pxCurrentTCB->ulHRRelease += pxCurrentTCB->ulHRPeriod;
+								ulRemaining = pxCurrentTCB->ulHRRelease - ulNow;
+
+								if( ( int32_t ) ulRemaining > 0 )
+								{
+										/* Wait in the delayed list so the task is seen as blocked,
+										 * with a wake time one tick after the release as a backstop
+										 * should the compare match be lost. */
+										pxCurrentTCB->ucHRWaiting = pdTRUE;
+										prvAddCurrentTaskToDelayedList( tskHR_COUNTS_TO_TICKS( ulRemaining ) + ( TickType_t ) 1, pdFALSE );
+								}
+								else
+								{
+										/* The next job is already due, release it now with the deadline
+										 * it has from its due time. */
+										( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+										taskPOLICY_RELEASE( pxCurrentTCB, tskHR_RELEASE_TICK( ( uint32_t ) 0UL - ulRemaining ) );
+										prvAddTaskToReadyList( pxCurrentTCB );
+								}
+
+								/* Program the compare match, and release any other task that
+								 * fell due in the meantime. */
+								if( prvHRReleaseDueTasks() != pdFALSE )
+								{
+										xYieldPending = pdTRUE;
+								}
+								else
+								{
+										mtCOVERAGE_TEST_MARKER();
+								}
+						}
+						taskEXIT_CRITICAL();
+				}
+				xAlreadyYielded = xTaskResumeAll();
+
+				/* Force a reschedule as the task either blocked or its new job may
+				 * no longer be the earliest deadline. */
+				if( xAlreadyYielded == pdFALSE )
+				{
+						portYIELD_WITHIN_API();
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+		}
+/*-----------------------------------------------------------*/
+
+		BaseType_t xTaskHighResolutionTimerHandlerFromISR( void )
+		{
+				BaseType_t xSwitchRequired = pdFALSE;
+				UBaseType_t uxSavedInterruptStatus;
+
+				uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+				{
+						if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+						{
+								xSwitchRequired = prvHRReleaseDueTasks();
+						}
+						else
+						{
+								/* The delayed and ready lists can not be touched, the releases
+								 * are done by xTaskResumeAll(). */
+								xHRReleasePending = pdTRUE;
+						}
+				}
+				portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+				return xSwitchRequired;
+		}
+/*-----------------------------------------------------------*/
+
+		static BaseType_t prvHRReleaseDueTasks( void )
+		{
+				TCB_t * pxTCB;
+				UBaseType_t x;
+				uint32_t ulNow, ulEarliest = 0UL;
+				BaseType_t xEarliestValid, xSwitchRequired = pdFALSE;
+
+				do
+				{
+						ulNow = configHR_TIMER_COUNT();
+						xEarliestValid = pdFALSE;
+
+						for( x = ( UBaseType_t ) 0U; x < uxHRTasks; x++ )
+						{
+								pxTCB = pxHRTasks[ x ];
+
+								if( pxTCB->ucHRWaiting == pdFALSE )
+								{
+										mtCOVERAGE_TEST_MARKER();
+								}
+								else if( ( listIS_CONTAINED_WITHIN( pxDelayedTaskList, &( pxTCB->xStateListItem ) ) == pdFALSE ) &&
+												 ( listIS_CONTAINED_WITHIN( pxOverflowDelayedTaskList, &( pxTCB->xStateListItem ) ) == pdFALSE ) )
+								{
+										/* No longer waiting for this release, it was released by the
+										 * tick or its delay was aborted. */
+										pxTCB->ucHRWaiting = pdFALSE;
+								}
+								else if( ( int32_t ) ( ulNow - pxTCB->ulHRRelease ) >= 0 )
+								{
+										/* A stale xNextTaskUnblockTime left by the removal is put
+										 * right by the tick. */
+										( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+										pxTCB->ucHRWaiting = pdFALSE;
+
+										taskPOLICY_RELEASE( pxTCB, tskHR_RELEASE_TICK( ulNow - pxTCB->ulHRRelease ) );
+										prvAddTaskToReadyList( pxTCB );
+
+										if( taskPOLICY_SHOULD_PREEMPT( pxTCB ) != pdFALSE )
+										{
+												xSwitchRequired = pdTRUE;
+										}
+										else
+										{
+												mtCOVERAGE_TEST_MARKER();
+										}
+								}
+								else if( ( xEarliestValid == pdFALSE ) || ( ( int32_t ) ( pxTCB->ulHRRelease - ulEarliest ) < 0 ) )
+								{
+										ulEarliest = pxTCB->ulHRRelease;
+										xEarliestValid = pdTRUE;
+								}
+								else
+								{
+										mtCOVERAGE_TEST_MARKER();
+								}
+						}
+
+						if( xEarliestValid != pdFALSE )
+						{
+								configHR_TIMER_SET_COMPARE( ulEarliest );
+						}
+						else
+						{
+								configHR_TIMER_STOP_COMPARE();
+						}
+
+						/* A match programmed for a count that has already gone by would
+						 * not fire until the counter wraps, so go round again. */
+				} while( ( xEarliestValid != pdFALSE ) && ( ( int32_t ) ( ulEarliest - configHR_TIMER_COUNT() ) <= 0 ) );
+
+				return xSwitchRequired;
+		}
+
+#endif /* configUSE_HIGH_RESOLUTION_RELEASES */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_DEFERRED_RELEASES == 1 ) )
+
+		static portTASK_FUNCTION( prvReleaseTask, pvParameters )
+		{
+				TCB_t * pxTCB;
+				TickType_t xReleaseTime;
+
+				/* Stop warnings. */
+				( void ) pvParameters;
+
+				for( ; ; )
+				{
+						/* One release per critical section, so an interrupt waits for
+						 * at most one sorted insertion. */
+						taskENTER_CRITICAL();
+						{
+								if( listLIST_IS_EMPTY( &xPendingReleaseList ) == pdFALSE )
+								{
+										pxTCB = listGET_OWNER_OF_HEAD_ENTRY( &xPendingReleaseList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+										xReleaseTime = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+										( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+										/* What the tick does without deferred releases. */
+										taskPOLICY_RELEASE( pxTCB, xReleaseTime );
+										prvAddTaskToReadyList( pxTCB );
+
+										#if ( configUSE_MK_FIRM == 1 )
+												prvMKShedLoad( pxTCB );
+										#endif
+								}
+								else
+								{
+										/* Everything is released.  Leave the ready list, the task
+										 * at its head is the one with the earliest deadline. */
+										( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+										portYIELD_WITHIN_API();
+								}
+						}
+						taskEXIT_CRITICAL();
+				}
+		}
+/*-----------------------------------------------------------*/
+
+		static BaseType_t prvReleaseTaskWake( void )
+		{
+				TCB_t * const pxTCB = xReleaseTaskHandle;
+				BaseType_t xReturn = pdFALSE;
+
+				if( listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) ) == NULL )
+				{
+						/* A key of 0 goes ahead of every job, so the insertion stops at
+						 * the head of the ready list. */
+						listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), ( TickType_t ) 0U );
+						vListInsert( &xReadyTasksListEDF, &( pxTCB->xStateListItem ) );
+						xReturn = taskPOLICY_SHOULD_PREEMPT( pxTCB );
+				}
+				else
+				{
+						/* Already ready or running, it will find the new release. */
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				return xReturn;
+		}
+
+#endif /* configUSE_DEFERRED_RELEASES */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_BUCKETS == 1 ) )
+
+		#if !defined( __GNUC__ )
+
+				static UBaseType_t prvCountLeadingZeros( uint32_t ulBits )
+				{
+						UBaseType_t uxZeros = ( UBaseType_t ) 0U;
+
+						/* Binary search for the most significant set bit. */
+						if( ( ulBits & 0xffff0000UL ) == 0UL )
+						{
+								uxZeros += ( UBaseType_t ) 16U;
+								ulBits <<= 16;
+						}
+
+						if( ( ulBits & 0xff000000UL ) == 0UL )
+						{
+								uxZeros += ( UBaseType_t ) 8U;
+								ulBits <<= 8;
+						}
+
+						if( ( ulBits & 0xf0000000UL ) == 0UL )
+						{
+								uxZeros += ( UBaseType_t ) 4U;
+								ulBits <<= 4;
+						}
+
+						if( ( ulBits & 0xc0000000UL ) == 0UL )
+						{
+								uxZeros += ( UBaseType_t ) 2U;
+								ulBits <<= 2;
+						}
+
+						if( ( ulBits & 0x80000000UL ) == 0UL )
+						{
+								uxZeros += ( UBaseType_t ) 1U;
+						}
+
+						return uxZeros;
+				}
+/*-----------------------------------------------------------*/
+
+		#endif /* __GNUC__ */
+
+		static void prvReadySetInsert( TCB_t * pxTCB )
+		{
+				const TickType_t xBucket = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) ) >> configEDF_BUCKET_SHIFT;
+				BaseType_t xInWindow = pdTRUE;
+				UBaseType_t uxIndex;
+
+				if( pxTCB == xIdleTaskHandle )
+				{
+						/* The key of the idle task is raised in place, which only keeps
+						 * the order of the sorted list. */
+						xInWindow = pdFALSE;
+				}
+				else if( xBucketsEmptyEDF != pdFALSE )
+				{
+						/* Start the window at this job. */
+						xBucketBaseEDF = xBucket;
+						xBucketLastEDF = xBucket;
+						xBucketsEmptyEDF = pdFALSE;
+				}
+				else if( ( TickType_t ) ( xBucket - xBucketBaseEDF ) < ( TickType_t ) tskEDF_BUCKETS )
+				{
+						/* In the window. */
+						if( ( TickType_t ) ( xBucket - xBucketBaseEDF ) > ( TickType_t ) ( xBucketLastEDF - xBucketBaseEDF ) )
+						{
+								xBucketLastEDF = xBucket;
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+				else if( ( TickType_t ) ( xBucketLastEDF - xBucket ) < ( TickType_t ) tskEDF_BUCKETS )
+				{
+						/* Earlier than the window, but the window can be moved down to it
+						 * and still hold the latest job. */
+						xBucketBaseEDF = xBucket;
+				}
+				else
+				{
+						xInWindow = pdFALSE;
+				}
+
+				if( xInWindow != pdFALSE )
+				{
+						uxIndex = ( UBaseType_t ) ( xBucket & ( TickType_t ) ( tskEDF_BUCKETS - 1U ) );
+
+						/* The jobs of a bucket are few, so keep them sorted. */
+						vListInsert( &( xReadyBucketsEDF[ uxIndex ] ), &( pxTCB->xStateListItem ) );
+						ulBucketMapEDF[ uxIndex >> 5 ] |= ( 0x80000000UL >> ( uxIndex & ( UBaseType_t ) 31U ) );
+						ulBucketGroupMapEDF |= ( 0x80000000UL >> ( uxIndex >> 5 ) );
+				}
+				else
+				{
+						/* Outside the window, fall back on the sorted list. */
+						vListInsert( &xReadyTasksListEDF, &( pxTCB->xStateListItem ) );
+				}
+		}
+/*-----------------------------------------------------------*/
+
+		static TCB_t * prvReadySetHead( void )
+		{
+				TCB_t * pxTCB = NULL;
+				const List_t * pxBucket;
+				UBaseType_t uxStart, uxGroup, uxIndex;
+				uint32_t ulBits;
+
+				/* Find the first bucket that may hold jobs at or after the base of the
+				 * window, going round to the buckets before it. */
+				while( ( pxTCB == NULL ) && ( ulBucketGroupMapEDF != 0UL ) )
+				{
+						uxStart = ( UBaseType_t ) ( xBucketBaseEDF & ( TickType_t ) ( tskEDF_BUCKETS - 1U ) );
+						uxGroup = uxStart >> 5;
+						ulBits = ulBucketMapEDF[ uxGroup ] & ( 0xffffffffUL >> ( uxStart & ( UBaseType_t ) 31U ) );
+
+						if( ulBits == 0UL )
+						{
+								/* The groups after this one, then any group. */
+								ulBits = ( uxGroup < ( UBaseType_t ) 31U ) ? ( ulBucketGroupMapEDF & ( 0xffffffffUL >> ( uxGroup + ( UBaseType_t ) 1U ) ) ) : 0UL;
+
+								if( ulBits == 0UL )
+								{
+										ulBits = ulBucketGroupMapEDF;
+								}
+								else
+								{
+										mtCOVERAGE_TEST_MARKER();
+								}
+
+								uxGroup = configEDF_CLZ( ulBits );
+								ulBits = ulBucketMapEDF[ uxGroup ];
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+
+						uxIndex = ( uxGroup << 5 ) + configEDF_CLZ( ulBits );
+						pxBucket = &( xReadyBucketsEDF[ uxIndex ] );
+
+						if( listLIST_IS_EMPTY( pxBucket ) != pdFALSE )
+						{
+								/* The jobs of this bucket have left the ready set since. */
+								ulBucketMapEDF[ uxGroup ] &= ~( 0x80000000UL >> ( uxIndex & ( UBaseType_t ) 31U ) );
+
+								if( ulBucketMapEDF[ uxGroup ] == 0UL )
+								{
+										ulBucketGroupMapEDF &= ~( 0x80000000UL >> uxGroup );
+								}
+								else
+								{
+										mtCOVERAGE_TEST_MARKER();
+								}
+						}
+						else
+						{
+								pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxBucket ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+								/* No job in a bucket is earlier, so the window can start here. */
+								xBucketBaseEDF = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) ) >> configEDF_BUCKET_SHIFT;
+						}
+				}
+
+				if( pxTCB == NULL )
+				{
+						xBucketsEmptyEDF = pdTRUE;
+						pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xReadyTasksListEDF ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				}
+				else if( ( listLIST_IS_EMPTY( &xReadyTasksListEDF ) == pdFALSE ) &&
+								 ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( &xReadyTasksListEDF ) < listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) ) ) )
+				{
+						/* A job outside the window is the earliest. */
+						pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xReadyTasksListEDF ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				return pxTCB;
+		}
+
+#endif /* configUSE_EDF_BUCKETS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_ARRAY == 1 ) )
+
+		static void prvReadySetInsert( TCB_t * pxTCB )
+		{
+				const UBaseType_t uxSlot = pxTCB->uxReadySlot;
+
+				if( uxSlot != tskNO_READY_SLOT )
+				{
+						vListInsertEnd( &xReadyArrayListEDF, &( pxTCB->xStateListItem ) );
+						xReadyKeysEDF[ uxSlot ] = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+						ulReadyMaskEDF |= ( 1UL << uxSlot );
+				}
+				else
+				{
+						vListInsert( &xReadyTasksListEDF, &( pxTCB->xStateListItem ) );
+				}
+		}
+/*-----------------------------------------------------------*/
+
+		static TCB_t * prvReadySetHead( void )
+		{
+				TCB_t * pxTCB = NULL;
+				TickType_t xKey, xMin, xLess;
+				UBaseType_t x, uxMin, uxLess;
+
+				while( ( pxTCB == NULL ) && ( ulReadyMaskEDF != 0UL ) )
+				{
+						xMin = portMAX_DELAY;
+						uxMin = ( UBaseType_t ) 0U;
+
+						/* Keep the lowest key and its slot without a branch on the keys,
+						 * the first slot wins a tie. */
+						for( x = ( UBaseType_t ) 0U; x < uxReadySlotsUsedEDF; x++ )
+						{
+								xKey = xReadyKeysEDF[ x ];
+								xLess = ( TickType_t ) 0U - ( TickType_t ) ( xKey < xMin );
+								uxLess = ( UBaseType_t ) 0U - ( UBaseType_t ) ( xKey < xMin );
+								xMin = ( xKey & xLess ) | ( xMin & ~xLess );
+								uxMin = ( x & uxLess ) | ( uxMin & ~uxLess );
+						}
+
+						if( ( ulReadyMaskEDF & ( 1UL << uxMin ) ) == 0UL )
+						{
+								/* Only portMAX_DELAY left, which no slot in the mask has. */
+								break;
+						}
+						else if( listIS_CONTAINED_WITHIN( &xReadyArrayListEDF, &( pxReadySlotsEDF[ uxMin ]->xStateListItem ) ) == pdFALSE )
+						{
+								/* The task has left the ready set since, forget its key. */
+								xReadyKeysEDF[ uxMin ] = portMAX_DELAY;
+								ulReadyMaskEDF &= ~( 1UL << uxMin );
+						}
+						else
+						{
+								pxTCB = pxReadySlotsEDF[ uxMin ];
+						}
+				}
+
+				if( pxTCB == NULL )
+				{
+						pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xReadyTasksListEDF ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				}
+				else if( ( listLIST_IS_EMPTY( &xReadyTasksListEDF ) == pdFALSE ) &&
+								 ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( &xReadyTasksListEDF ) < xReadyKeysEDF[ pxTCB->uxReadySlot ] ) )
+				{
+						/* A task without a slot is the earliest. */
+						pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xReadyTasksListEDF ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				return pxTCB;
+		}
+
+#endif /* configUSE_EDF_ARRAY */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_SPORADIC_TASKS == 1 ) )
+
+		BaseType_t xTaskSporadicCreate( TaskFunction_t pxTaskCode,
+																		const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+																		const configSTACK_DEPTH_TYPE usStackDepth,
+																		void * const pvParameters,
+																		UBaseType_t uxPriority,
+																		TickType_t xMinInterArrival,
+																		TickType_t xRelativeDeadline,
+																		BaseType_t xPostponeEarly,
+																		TaskHandle_t * const pxCreatedTask )
+		{
+				TCB_t * pxTCB = NULL;
+				BaseType_t xReturn = pdFAIL;
+
+				configASSERT( xMinInterArrival > ( TickType_t ) 0U );
+
+				/* A deadline of 0 means the deadline is equal to the minimum
+				 * inter-arrival time. */
+				if( xRelativeDeadline == ( TickType_t ) 0U )
+				{
+						xRelativeDeadline = xMinInterArrival;
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* The task is created ready, keep it from running before it is moved
+				 * to wait for its first arrival. */
+				vTaskSuspendAll();
+				{
+						if( uxSporadicTasks < ( UBaseType_t ) configMAX_SPORADIC_TASKS )
+						{
+								/* The minimum inter-arrival time is the period of the worst
+								 * case arrival pattern, so it is also what the density of the
+								 * task is worked out from. */
+								xReturn = xTaskPeriodicCreate( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, xMinInterArrival, &pxTCB );
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+
+						if( xReturn == pdPASS )
+						{
+								taskENTER_CRITICAL();
+								{
+										pxTCB->xTaskRelativeDeadline = xRelativeDeadline;
+										pxTCB->xMinInterArrival = xMinInterArrival;
+										pxTCB->ucPostponeEarly = ( xPostponeEarly != pdFALSE ) ? pdTRUE : pdFALSE;
+
+										/* The first arrival is never early. */
+										pxTCB->xSporadicLastRelease = xTickCount - xMinInterArrival;
+
+										( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+										vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
+										pxTCB->ucSporadicWaiting = pdTRUE;
+
+										pxSporadicTasks[ uxSporadicTasks ] = pxTCB;
+										uxSporadicTasks++;
+
+										if( pxCurrentTCB == pxTCB )
+										{
+												taskPOLICY_SELECT();
+										}
+										else
+										{
+												mtCOVERAGE_TEST_MARKER();
+										}
+								}
+								taskEXIT_CRITICAL();
+
+								if( pxCreatedTask != NULL )
+								{
+										*pxCreatedTask = pxTCB;
+								}
+								else
+								{
+										mtCOVERAGE_TEST_MARKER();
+								}
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+				( void ) xTaskResumeAll();
+
+				return xReturn;
+		}
+/*-----------------------------------------------------------*/
+
+		void vTaskSporadicWait( void )
+		{
+				BaseType_t xAlreadyYielded;
+				TickType_t xTicksToWait = ( TickType_t ) 0U;
+
+				configASSERT( pxCurrentTCB->xMinInterArrival > ( TickType_t ) 0U );
+				configASSERT( uxSchedulerSuspended == 0 );
+
+				vTaskSuspendAll();
+				{
+						const TickType_t xConstTickCount = xTickCount;
+
+						#if ( configUSE_SCHEDULER_STATS == 1 )
+								{
+										/* Calling this function ends the current job, so check it
+										 * against its deadline. */
+										if( tskTICK_BEFORE( pxCurrentTCB->xTaskAbsoluteDeadline, xConstTickCount ) != pdFALSE )
+										{
+												( pxCurrentTCB->uxDeadlineMisses )++;
+										}
+										else
+										{
+												mtCOVERAGE_TEST_MARKER();
+										}
+								}
+						#endif
+
+						/* The arrival is written from interrupts too. */
+						taskENTER_CRITICAL();
+						{
+								if( pxCurrentTCB->ucSporadicPending == pdFALSE )
+								{
+										/* Nothing arrived during the job, wait for the next
+										 * arrival in xSuspendedTaskList. */
+										pxCurrentTCB->ucSporadicWaiting = pdTRUE;
+										xTicksToWait = portMAX_DELAY;
+								}
+								else if( tskTICK_BEFORE( xConstTickCount, pxCurrentTCB->xSporadicNextRelease ) != pdFALSE )
+								{
+										/* The arrival was postponed, the tick releases the next job
+										 * when it is due. */
+										pxCurrentTCB->ucSporadicPending = pdFALSE;
+										pxCurrentTCB->xSporadicLastRelease = pxCurrentTCB->xSporadicNextRelease;
+										xTicksToWait = pxCurrentTCB->xSporadicNextRelease - xConstTickCount;
+								}
+								else
+								{
+										/* The next job is already due.  Release it at the time it
+										 * arrived rather than now, as xTaskDelayUntil() does for a
+										 * late periodic job. */
+										pxCurrentTCB->ucSporadicPending = pdFALSE;
+										pxCurrentTCB->xSporadicLastRelease = pxCurrentTCB->xSporadicNextRelease;
+										( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+										taskPOLICY_RELEASE( pxCurrentTCB, pxCurrentTCB->xSporadicNextRelease );
+										prvAddTaskToReadyList( pxCurrentTCB );
+								}
+						}
+						taskEXIT_CRITICAL();
+
+						if( xTicksToWait != ( TickType_t ) 0U )
+						{
+								/* An arrival from an interrupt before the task has left the
+								 * ready list finds the scheduler suspended, and is completed
+								 * by xTaskResumeAll() from xPendingReadyList. */
+								prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+				xAlreadyYielded = xTaskResumeAll();
+
+				if( xAlreadyYielded == pdFALSE )
+				{
+						portYIELD_WITHIN_API();
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+		}
+/*-----------------------------------------------------------*/
+
+		BaseType_t xTaskSporadicRelease( TaskHandle_t xTask )
+		{
+				TCB_t * const pxTCB = xTask;
+				BaseType_t xReturn, xSwitchRequired = pdFALSE;
+
+				configASSERT( pxTCB );
+				configASSERT( pxTCB->xMinInterArrival > ( TickType_t ) 0U );
+
+				taskENTER_CRITICAL();
+				{
+						xReturn = prvSporadicArrival( pxTCB, &xSwitchRequired );
+				}
+				taskEXIT_CRITICAL();
+
+				if( xSwitchRequired != pdFALSE )
+				{
+						taskYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				return xReturn;
+		}
+/*-----------------------------------------------------------*/
+
+		BaseType_t xTaskSporadicReleaseFromISR( TaskHandle_t xTask,
+																						BaseType_t * const pxHigherPriorityTaskWoken )
+		{
+				TCB_t * const pxTCB = xTask;
+				BaseType_t xReturn, xSwitchRequired = pdFALSE;
+				UBaseType_t uxSavedInterruptStatus;
+
+				configASSERT( pxTCB );
+				configASSERT( pxTCB->xMinInterArrival > ( TickType_t ) 0U );
+
+				portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+				uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+				{
+						xReturn = prvSporadicArrival( pxTCB, &xSwitchRequired );
+				}
+				portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+				if( ( xSwitchRequired != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+				{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				return xReturn;
+		}
+/*-----------------------------------------------------------*/
+
+		UBaseType_t uxTaskGetRejectedReleaseCount( TaskHandle_t xTask )
+		{
+				TCB_t * pxTCB;
+
+				/* If xTask is NULL then the count of the calling task is returned. */
+				pxTCB = prvGetTCBFromHandle( xTask );
+
+				return pxTCB->uxRejectedReleases;
+		}
+/*-----------------------------------------------------------*/
+
+		static BaseType_t prvSporadicArrival( TCB_t * pxTCB,
+																					BaseType_t * pxSwitchRequired )
+		{
+				const TickType_t xConstTickCount = xTickCount;
+				const TickType_t xEarliest = pxTCB->xSporadicLastRelease + pxTCB->xMinInterArrival;
+				const BaseType_t xEarly = tskTICK_BEFORE( xConstTickCount, xEarliest );
+				BaseType_t xReturn = pdPASS;
+
+				if( ( pxTCB->ucSporadicPending != pdFALSE ) ||
+						( ( xEarly != pdFALSE ) && ( pxTCB->ucPostponeEarly == pdFALSE ) ) )
+				{
+						/* Only one arrival is held at a time, and an early one only if
+						 * the task postpones early arrivals. */
+						( pxTCB->uxRejectedReleases )++;
+						xReturn = pdFAIL;
+				}
+				else if( ( xEarly == pdFALSE ) && ( pxTCB->ucSporadicWaiting != pdFALSE ) )
+				{
+						prvSporadicRelease( pxTCB, xConstTickCount, pxSwitchRequired );
+				}
+				else
+				{
+						/* Held until the current job ends, or until the minimum
+						 * inter-arrival time has passed. */
+						pxTCB->xSporadicNextRelease = ( xEarly != pdFALSE ) ? xEarliest : xConstTickCount;
+						pxTCB->ucSporadicPending = pdTRUE;
+				}
+
+				return xReturn;
+		}
+/*-----------------------------------------------------------*/
+
+		static void prvSporadicRelease( TCB_t * pxTCB,
+																		TickType_t xReleaseTime,
+																		BaseType_t * pxSwitchRequired )
+		{
+				pxTCB->ucSporadicWaiting = pdFALSE;
+				pxTCB->xSporadicLastRelease = xReleaseTime;
+				taskPOLICY_RELEASE( pxTCB, xReleaseTime );
+
+				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+				{
+						( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+						prvAddTaskToReadyList( pxTCB );
+
+						#if ( configUSE_MK_FIRM == 1 )
+								prvMKShedLoad( pxTCB );
+						#endif
+
+						if( ( taskIS_READY_EDF( pxTCB ) != pdFALSE ) &&
+								( taskPOLICY_SHOULD_PREEMPT( pxTCB ) != pdFALSE ) )
+						{
+								*pxSwitchRequired = pdTRUE;
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+				else
+				{
+						/* The ready list can not be accessed, xTaskResumeAll() moves the
+						 * task once the scheduler is resumed.  The key it gives the task
+						 * is the deadline of the job released here, and it runs
+						 * prvMKShedLoad() for the job as it has not started. */
+						vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+				}
+		}
+/*-----------------------------------------------------------*/
+
+		static void prvSporadicTick( BaseType_t * pxSwitchRequired )
+		{
+				const TickType_t xConstTickCount = xTickCount;
+				TCB_t * pxTCB;
+				TickType_t xSinceLastRelease;
+				UBaseType_t x;
+
+				for( x = ( UBaseType_t ) 0U; x < uxSporadicTasks; x++ )
+				{
+						pxTCB = pxSporadicTasks[ x ];
+						xSinceLastRelease = ( TickType_t ) ( xConstTickCount - pxTCB->xSporadicLastRelease );
+
+						if( ( pxTCB->ucSporadicPending != pdFALSE ) && ( pxTCB->ucSporadicWaiting != pdFALSE ) )
+						{
+								/* A postponed arrival of a waiting task. */
+								if( tskTICK_BEFORE( xConstTickCount, pxTCB->xSporadicNextRelease ) == pdFALSE )
+								{
+										pxTCB->ucSporadicPending = pdFALSE;
+										prvSporadicRelease( pxTCB, pxTCB->xSporadicNextRelease, pxSwitchRequired );
+								}
+								else
+								{
+										mtCOVERAGE_TEST_MARKER();
+								}
+						}
+						else if( ( xSinceLastRelease > pxTCB->xMinInterArrival ) && ( xSinceLastRelease <= ( portMAX_DELAY >> 1 ) ) )
+						{
+								/* Only whether the last release was less than the minimum
+								 * inter-arrival time ago matters.  Keep it no further back
+								 * than that so tskTICK_BEFORE() does not take a release made
+								 * long ago for one still to come. */
+								pxTCB->xSporadicLastRelease = xConstTickCount - pxTCB->xMinInterArrival;
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+		}
+
+#endif /* configUSE_SPORADIC_TASKS */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_MIXED_CRITICALITY == 1 ) )
+
+		BaseType_t xTaskSetCriticality( TaskHandle_t xTask,
+																		BaseType_t xHighCriticality,
+																		TickType_t xBudgetLO,
+																		TickType_t xBudgetHI )
+		{
+				TCB_t * pxTCB;
+				uint32_t ulFactor;
+				UBaseType_t x;
+				BaseType_t xReturn = pdPASS;
+
+				configASSERT( xBudgetLO > ( TickType_t ) 0U );
+
+				/* A LO task only has a LO budget. */
+				if( xHighCriticality == pdFALSE )
+				{
+						xBudgetHI = xBudgetLO;
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				configASSERT( xBudgetHI >= xBudgetLO );
+
+				taskENTER_CRITICAL();
+				{
+						/* If xTask is NULL then the calling task is given the criticality. */
+						pxTCB = prvGetTCBFromHandle( xTask );
+
+						if( ( pxTCB->ucCriticality == tskCRITICALITY_NONE ) && ( uxCriticalityTasks >= ( UBaseType_t ) configMAX_CRITICALITY_TASKS ) )
+						{
+								xReturn = pdFAIL;
+						}
+						else
+						{
+								ulFactor = prvCriticalityTest( pxTCB, xHighCriticality, xBudgetLO, xBudgetHI, NULL );
+
+								if( ulFactor == tskCRITICALITY_NOT_SCHEDULABLE )
+								{
+										xReturn = pdFAIL;
+								}
+								else
+								{
+										mtCOVERAGE_TEST_MARKER();
+								}
+						}
+
+						if( xReturn != pdFAIL )
+						{
+								if( pxTCB->ucCriticality == tskCRITICALITY_NONE )
+								{
+										pxCriticalityTasks[ uxCriticalityTasks ] = pxTCB;
+										uxCriticalityTasks++;
+								}
+								else
+								{
+										/* Already in the task set, just update its parameters. */
+										mtCOVERAGE_TEST_MARKER();
+								}
+
+								pxTCB->ucCriticality = ( xHighCriticality != pdFALSE ) ? tskCRITICALITY_HI : tskCRITICALITY_LO;
+								pxTCB->xBudgetLO = xBudgetLO;
+								pxTCB->xBudgetHI = xBudgetHI;
+
+								/* The new virtual deadlines are used from the next release. */
+								ulCriticalityFactor = ulFactor;
+
+								for( x = ( UBaseType_t ) 0U; x < uxCriticalityTasks; x++ )
+								{
+										prvCriticalityVirtualDeadline( pxCriticalityTasks[ x ] );
+								}
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+				taskEXIT_CRITICAL();
+
+				return xReturn;
+		}
+/*-----------------------------------------------------------*/
+
+		static void prvCriticalityWindow( const TCB_t * pxTCB,
+																			const CriticalityChange_t * pxChange,
+																			TickType_t * pxPeriod,
+																			TickType_t * pxDeadline )
+		{
+				*pxPeriod = pxTCB->xTaskPeriod;
+				*pxDeadline = pxTCB->xTaskRelativeDeadline;
+
+				#if ( configUSE_MODE_CHANGE == 1 )
+						{
+								UBaseType_t x;
+
+								/* The task set is tested as it will be once every pending change,
+								 * and the one being asked for, is applied. */
+								if( pxTCB->ucPeriodChangePending != pdFALSE )
+								{
+										*pxPeriod = pxTCB->xTaskPendingPeriod;
+										*pxDeadline = pxTCB->xTaskPendingDeadline;
+								}
+								else
+								{
+										mtCOVERAGE_TEST_MARKER();
+								}
+
+								if( pxChange != NULL )
+								{
+										for( x = ( UBaseType_t ) 0U; x < pxChange->uxNumberOfTasks; x++ )
+										{
+												if( prvGetTCBFromHandle( pxChange->pxTasks[ x ] ) == pxTCB )
+												{
+														*pxPeriod = pxChange->pxPeriods[ x ];
+														*pxDeadline = ( ( pxChange->pxDeadlines == NULL ) || ( pxChange->pxDeadlines[ x ] == ( TickType_t ) 0U ) ) ? pxChange->pxPeriods[ x ] : pxChange->pxDeadlines[ x ];
+												}
+												else
+												{
+														mtCOVERAGE_TEST_MARKER();
+												}
+										}
+								}
+								else
+								{
+										mtCOVERAGE_TEST_MARKER();
+								}
+						}
+				#else /* configUSE_MODE_CHANGE */
+						{
+								( void ) pxChange;
+						}
+				#endif /* configUSE_MODE_CHANGE */
+		}
+/*-----------------------------------------------------------*/
+
+		static uint32_t prvCriticalityTest( const TCB_t * pxTCB,
+																				BaseType_t xHighCriticality,
+																				TickType_t xBudgetLO,
+																				TickType_t xBudgetHI,
+																				const CriticalityChange_t * pxChange )
+		{
+				const TCB_t * pxOtherTCB;
+				uint32_t ulLoLo = 0UL, ulHiLo = 0UL, ulHiHi = 0UL, ulFactor = 0UL, ulNone = 0UL;
+				TickType_t xPeriod, xDeadline;
+				UBaseType_t x;
+
+				/* The utilisations of the task set with the new parameters of
+				 * pxTCB, if any: LO tasks at their LO budget, HI tasks at their LO and
+				 * at their HI budget. */
+				for( x = ( UBaseType_t ) 0U; x < uxCriticalityTasks; x++ )
+				{
+						pxOtherTCB = pxCriticalityTasks[ x ];
+						prvCriticalityWindow( pxOtherTCB, pxChange, &xPeriod, &xDeadline );
+
+						if( pxOtherTCB == pxTCB )
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+						else if( pxOtherTCB->ucCriticality == tskCRITICALITY_HI )
+						{
+								ulHiLo += tskCRITICALITY_UTILISATION( pxOtherTCB->xBudgetLO, xPeriod );
+								ulHiHi += tskCRITICALITY_UTILISATION( pxOtherTCB->xBudgetHI, xPeriod );
+						}
+						else
+						{
+								ulLoLo += tskCRITICALITY_UTILISATION( pxOtherTCB->xBudgetLO, xPeriod );
+						}
+				}
+
+				/* The tasks without a criticality are never put in the background,
+				 * so they count as HI tasks that keep their real deadlines, with
+				 * their worst case execution time as both budgets.  A task whose
+				 * execution time is not known counts for nothing. */
+				for( x = ( UBaseType_t ) 0U; x < tskEDF_READY_LISTS; x++ )
+				{
+						ulNone += prvCriticalityNoneLoad( taskEDF_READY_LIST( x ), pxTCB, pxChange );
+				}
+
+				ulNone += prvCriticalityNoneLoad( pxDelayedTaskList, pxTCB, pxChange );
+				ulNone += prvCriticalityNoneLoad( pxOverflowDelayedTaskList, pxTCB, pxChange );
+
+				#if ( INCLUDE_vTaskSuspend == 1 )
+						{
+								ulNone += prvCriticalityNoneLoad( &xSuspendedTaskList, pxTCB, pxChange );
+						}
+				#endif
+
+				ulHiLo += ulNone;
+				ulHiHi += ulNone;
+
+				if( pxTCB != NULL )
+				{
+						prvCriticalityWindow( pxTCB, pxChange, &xPeriod, &xDeadline );
+
+						if( xHighCriticality != pdFALSE )
+						{
+								ulHiLo += tskCRITICALITY_UTILISATION( xBudgetLO, xPeriod );
+								ulHiHi += tskCRITICALITY_UTILISATION( xBudgetHI, xPeriod );
+						}
+						else
+						{
+								ulLoLo += tskCRITICALITY_UTILISATION( xBudgetLO, xPeriod );
+						}
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* EDF-VD, for implicit deadlines.  LO mode is schedulable if the
+				 * virtual deadlines are the real ones scaled by
+				 * x = U_HI(LO) / ( 1 - U_LO(LO) ), with x at most 1.  HI mode is
+				 * then schedulable if x * U_LO(LO) + U_HI(HI) <= 1. */
+				if( ( ulLoLo + ulHiLo ) > tskCRITICALITY_ONE )
+				{
+						ulFactor = tskCRITICALITY_NOT_SCHEDULABLE;
+				}
+				else if( ulHiLo > 0UL )
+				{
+						/* tskCRITICALITY_ONE - ulLoLo is at least ulHiLo, so x is at
+						 * most 1 but for rounding. */
+						if( ( ( tskCRITICALITY_ONE - ulLoLo ) >> 8 ) > 0UL )
+						{
+								ulFactor = ( ulHiLo << 8 ) / ( ( tskCRITICALITY_ONE - ulLoLo ) >> 8 );
+						}
+						else
+						{
+								ulFactor = tskCRITICALITY_ONE;
+						}
+
+						if( ulFactor > tskCRITICALITY_ONE )
+						{
+								ulFactor = tskCRITICALITY_ONE;
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+
+						if( ( ( ( ulFactor * ulLoLo ) >> tskCRITICALITY_SHIFT ) + ulHiHi ) > tskCRITICALITY_ONE )
+						{
+								ulFactor = tskCRITICALITY_NOT_SCHEDULABLE;
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+				else
+				{
+						/* No HI utilisation, the factor does not matter. */
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				return ulFactor;
+		}
+/*-----------------------------------------------------------*/
+
+		static void prvCriticalityVirtualDeadline( TCB_t * pxTCB )
+		{
+				pxTCB->xVirtualDeadline = ( TickType_t ) ( ( ( uint32_t ) pxTCB->xTaskRelativeDeadline * ( ulCriticalityFactor >> 8 ) ) >> 8 );
+
+				/* A virtual deadline shorter than the LO budget can not be met. */
+				if( pxTCB->xVirtualDeadline < pxTCB->xBudgetLO )
+				{
+						pxTCB->xVirtualDeadline = pxTCB->xBudgetLO;
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+		}
+/*-----------------------------------------------------------*/
+
+		BaseType_t xTaskGetCriticalityMode( void )
+		{
+				/* pdTRUE in HI mode. */
+				return xCriticalityHigh;
+		}
+/*-----------------------------------------------------------*/
+
+		uint32_t ulTaskGetCriticalitySwitchCount( void )
+		{
+				return ulCriticalitySwitchCount;
+		}
+/*-----------------------------------------------------------*/
+
+		uint32_t ulTaskGetBudgetOverrunCount( void )
+		{
+				return ulBudgetOverrunCount;
+		}
+/*-----------------------------------------------------------*/
+
+		static TickType_t prvCriticalityKey( const TCB_t * pxTCB )
+		{
+				TickType_t xKey = pxTCB->xTaskAbsoluteDeadline;
+
+				if( pxTCB->ucCriticality == tskCRITICALITY_HI )
+				{
+						/* In LO mode a HI job is sorted by its virtual deadline.  One that
+						 * has overrun its HI budget only runs when no other job is ready. */
+						if( pxTCB->xJobExecution > pxTCB->xBudgetHI )
+						{
+								xKey = tskCRITICALITY_BACKGROUND_KEY;
+						}
+						else if( ( xCriticalityHigh == pdFALSE ) && ( pxTCB->xVirtualDeadline < pxTCB->xTaskRelativeDeadline ) )
+						{
+								xKey -= ( pxTCB->xTaskRelativeDeadline - pxTCB->xVirtualDeadline );
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+				else if( ( pxTCB->ucCriticality == tskCRITICALITY_LO ) &&
+								 ( ( xCriticalityHigh != pdFALSE ) || ( pxTCB->xJobExecution > pxTCB->xBudgetLO ) ) )
+				{
+						/* A LO job in HI mode, or one that has overrun its budget, only
+						 * runs when no other job is ready. */
+						xKey = tskCRITICALITY_BACKGROUND_KEY;
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				return xKey;
+		}
+/*-----------------------------------------------------------*/
+
+		static void prvCriticalityTick( BaseType_t * pxSwitchRequired )
+		{
+				TCB_t * const pxTCB = pxCurrentTCB;
+				TCB_t * pxHead;
+				BaseType_t xResorted = pdFALSE;
+
+				if( pxTCB->ucCriticality != tskCRITICALITY_NONE )
+				{
+						( pxTCB->xJobExecution )++;
+
+						/* Only true on the tick that takes the job past its LO budget. */
+						if( pxTCB->xJobExecution == ( TickType_t ) ( pxTCB->xBudgetLO + ( TickType_t ) 1U ) )
+						{
+								if( pxTCB->ucCriticality == tskCRITICALITY_HI )
+								{
+										if( xCriticalityHigh == pdFALSE )
+										{
+												prvCriticalitySwitch( pdTRUE );
+												xResorted = pdTRUE;
+										}
+										else
+										{
+												mtCOVERAGE_TEST_MARKER();
+										}
+								}
+								else if( taskIS_READY_EDF( pxTCB ) != pdFALSE )
+								{
+										/* The rest of the LO job runs in the background. */
+										( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+										listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), prvCriticalityKey( pxTCB ) );
+										prvAddTaskToReadyList( pxTCB );
+										xResorted = pdTRUE;
+								}
+								else
+								{
+										mtCOVERAGE_TEST_MARKER();
+								}
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+
+						/* Only true on the tick that takes a HI job past its HI budget,
+						 * which the schedulability test assumed never happens.  The rest
+						 * of the job runs in the background so the overrun can not make
+						 * the other jobs miss. */
+						if( ( pxTCB->ucCriticality == tskCRITICALITY_HI ) &&
+								( pxTCB->xJobExecution == ( TickType_t ) ( pxTCB->xBudgetHI + ( TickType_t ) 1U ) ) )
+						{
+								ulBudgetOverrunCount++;
+
+								#if ( configUSE_BUDGET_OVERRUN_HOOK == 1 )
+										{
+												extern void vApplicationBudgetOverrunHook( TaskHandle_t xTask );
+
+												vApplicationBudgetOverrunHook( ( TaskHandle_t ) pxTCB );
+										}
+								#endif
+
+								if( taskIS_READY_EDF( pxTCB ) != pdFALSE )
+								{
+										( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+										listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), prvCriticalityKey( pxTCB ) );
+										prvAddTaskToReadyList( pxTCB );
+										xResorted = pdTRUE;
+								}
+								else
+								{
+										mtCOVERAGE_TEST_MARKER();
+								}
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Back to LO mode at an idle instant, once nothing but the idle task
+				 * is ready.  Every job released in HI mode has then completed,
+				 * including those that ran in the background, so the LO tasks can
+				 * go back to their own deadlines without taking time a HI job was
+				 * given in HI mode. */
+				if( ( xCriticalityHigh != pdFALSE ) && ( taskREADY_SET_HEAD() == xIdleTaskHandle ) )
+				{
+						prvCriticalitySwitch( pdFALSE );
+						xResorted = pdTRUE;
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* The keys changed, switch if the new head may preempt the running
+				 * job, which a non-preemptive region can still hold off. */
+				if( xResorted != pdFALSE )
+				{
+						pxHead = taskREADY_SET_HEAD();
+
+						if( ( pxHead != pxCurrentTCB ) && ( taskPOLICY_SHOULD_PREEMPT( pxHead ) != pdFALSE ) )
+						{
+								*pxSwitchRequired = pdTRUE;
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+		}
+/*-----------------------------------------------------------*/
+
+		static void prvCriticalitySwitch( BaseType_t xHigh )
+		{
+				TCB_t * pxTCB;
+				UBaseType_t x;
+
+				xCriticalityHigh = xHigh;
+
+				if( xHigh != pdFALSE )
+				{
+						ulCriticalitySwitchCount++;
+				}
+				else
+				{
+						mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Sort the ready jobs of the task set by their key in the new mode,
+				 * the jobs released later get it from taskPOLICY_RELEASE(). */
+				for( x = ( UBaseType_t ) 0U; x < uxCriticalityTasks; x++ )
+				{
+						pxTCB = pxCriticalityTasks[ x ];
+
+						if( taskIS_READY_EDF( pxTCB ) != pdFALSE )
+						{
+								( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+								listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), prvCriticalityKey( pxTCB ) );
+								prvAddTaskToReadyList( pxTCB );
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+		}
+/*-----------------------------------------------------------*/
+
+		static uint32_t prvCriticalityNoneLoad( const List_t * pxList,
+																						const TCB_t * pxExcludedTCB,
+																						const CriticalityChange_t * pxChange )
+		{
+				const ListItem_t * pxEndMarker = listGET_END_MARKER( pxList );
+				ListItem_t * pxIterator;
+				TCB_t * pxTCB;
+				TickType_t xPeriod, xDeadline;
+				uint32_t ulLoad = 0UL;
+
+				/* Walk the list without moving its index, the ready lists rely on it. */
+				for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+				{
+						pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+						if( ( pxTCB->ucCriticality == tskCRITICALITY_NONE ) &&
+								( pxTCB != pxExcludedTCB ) &&
+								( pxTCB != xIdleTaskHandle ) &&
+								( pxTCB->xTaskPeriod > ( TickType_t ) 0U ) )
+						{
+								/* A job has to complete within the shorter of its deadline and
+								 * its period. */
+								prvCriticalityWindow( pxTCB, pxChange, &xPeriod, &xDeadline );
+
+								if( ( xDeadline > ( TickType_t ) 0U ) && ( xDeadline < xPeriod ) )
+								{
+										xPeriod = xDeadline;
+								}
+								else
+								{
+										mtCOVERAGE_TEST_MARKER();
+								}
+
+								ulLoad += tskCRITICALITY_UTILISATION( pxTCB->xTaskWCET, xPeriod );
+						}
+						else
+						{
+								mtCOVERAGE_TEST_MARKER();
+						}
+				}
+
+				return ulLoad;
+		}
+
+#endif /* configUSE_MIXED_CRITICALITY */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_SCHEDULER_STATS == 1 ) )
+
+		/* Scheduler statistics used to compare the scheduling policies on the same
+		 * task set: context switches, deadline misses and kernel overhead (in
+		 * configBENCHMARK_COUNTER_VALUE() counts). */
+		uint32_t ulTaskGetContextSwitchCount( void )
+		{
+				return ulContextSwitchCount;
+		}
+/*-----------------------------------------------------------*/
+
+		uint32_t ulTaskGetKernelOverheadTime( void )
+		{
+				return ulKernelOverheadTime;
+		}
+/*-----------------------------------------------------------*/
+
+		UBaseType_t uxTaskGetDeadlineMissCount( TaskHandle_t xTask )
+		{
+				TCB_t * pxTCB;
+
+				/* If xTask is NULL then get the calling task's misses. */
+				pxTCB = prvGetTCBFromHandle( xTask );
+
+				return pxTCB->uxDeadlineMisses;
+		}
+/*-----------------------------------------------------------*/
+
+		void vTaskResetSchedulerStats( void )
+		{
+				taskENTER_CRITICAL();
+				{
+						ulContextSwitchCount = 0UL;
+						ulKernelOverheadTime = 0UL;
+				}
+				taskEXIT_CRITICAL();
+		}
+
+#endif /* configUSE_SCHEDULER_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    void vTaskSetApplicationTaskTag( TaskHandle_t xTask,
+                                     TaskHookFunction_t pxHookFunction )
+    {
+        TCB_t * xTCB;
+
+        /* If xTask is NULL then it is the task hook of the calling task that is
+         * getting set. */
+        if( xTask == NULL )
+        {
+            xTCB = ( TCB_t * ) pxCurrentTCB;
+        }
+        else
+        {
+            xTCB = xTask;
+        }
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        taskENTER_CRITICAL();
+        {
+            xTCB->pxTaskTag = pxHookFunction;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    TaskHookFunction_t xTaskGetApplicationTaskTag( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        TaskHookFunction_t xReturn;
+
+        /* If xTask is NULL then set the calling task's hook. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        taskENTER_CRITICAL();
+        {
+            xReturn = pxTCB->pxTaskTag;
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    TaskHookFunction_t xTaskGetApplicationTaskTagFromISR( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        TaskHookFunction_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+
+        /* If xTask is NULL then set the calling task's hook. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            xReturn = pxTCB->pxTaskTag;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
+                                             void * pvParameter )
+    {
+        TCB_t * xTCB;
+        BaseType_t xReturn;
+
+        /* If xTask is NULL then we are calling our own task hook. */
+        if( xTask == NULL )
+        {
+            xTCB = pxCurrentTCB;
+        }
+        else
+        {
+            xTCB = xTask;
+        }
+
+        if( xTCB->pxTaskTag != NULL )
+        {
+            xReturn = xTCB->pxTaskTag( pvParameter );
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
 
 void vTaskSwitchContext( void )
 {
+    #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_SCHEDULER_STATS == 1 ) )
+        const uint32_t ulEntryTime = configBENCHMARK_COUNTER_VALUE();
+        TCB_t * const pxPreviousTCB = pxCurrentTCB;
+    #endif
+
+    #if ( configUSE_KERNEL_BENCHMARK == 1 )
+        const uint32_t ulBenchmarkStartTime = configBENCHMARK_COUNTER_VALUE();
+    #endif
+
     if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
     {
         /* The scheduler is currently suspended - do not allow a context
@@ -3584,6 +8361,25 @@ void vTaskSwitchContext( void )
         xYieldPending = pdFALSE;
         traceTASK_SWITCHED_OUT();
 
+        #if ( configUSE_BLOCKING_PROFILER == 1 )
+            {
+                /* A task that yields from a critical section leaves it until
+                 * it runs again, so end the measurement here and keep the
+                 * nesting with the task. */
+                if( uxBlockingCriticalDepth != ( UBaseType_t ) 0U )
+                {
+                    prvBlockingRecord( tskBLOCK_INTERRUPTS_MASKED, ulBlockingCriticalStart, ulBlockingCriticalSite );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxCurrentTCB->uxBlockingDepth = uxBlockingCriticalDepth;
+                pxCurrentTCB->ulBlockingSite = ulBlockingCriticalSite;
+            }
+        #endif
+
         #if ( configGENERATE_RUN_TIME_STATS == 1 )
             {
                 #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
@@ -3630,13 +8426,93 @@ void vTaskSwitchContext( void )
 				}					
 				#else
 				{
-						// Used with EDF scheduler to select a new task to run which has the earliest deadline.
-						pxCurrentTCB = (TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &(xReadyTasksListEDF ) );
+						// Used with EDF scheduler to select a new task to run which has the earliest deadline (the lowest key of the selected policy).
+						#if ( configUSE_ABORT_ON_MISS == 1 )
+								{
+										/* Stale jobs are aborted rather than run, starting with the
+										 * task that was running if it was switched out because its
+										 * job missed its deadline. */
+										( void ) prvAbortMissedJob( pxCurrentTCB );
+								}
+						#endif
+
+						#if ( configUSE_LIMITED_PREEMPTION == 1 )
+								{
+										/* Whatever asked for the switch, a job in a non-preemptive
+										 * region keeps the processor until the region ends or runs
+										 * out of its length, unless it blocked. */
+										if( ( pxCurrentTCB->uxNPRNesting > ( UBaseType_t ) 0U ) &&
+												( ( TickType_t ) ( xTickCount - pxCurrentTCB->xNPRStartTime ) < pxCurrentTCB->xMaxNPRLength ) &&
+												( taskIS_READY_EDF( pxCurrentTCB ) != pdFALSE ) )
+										{
+												if( taskREADY_SET_HEAD() != pxCurrentTCB )
+												{
+														xPreemptionDeferred = pdTRUE;
+												}
+												else
+												{
+														mtCOVERAGE_TEST_MARKER();
+												}
+										}
+										else
+										{
+												taskPOLICY_SELECT();
+
+												/* The choice is made again here, so nothing is held off any more. */
+												xPreemptionDeferred = pdFALSE;
+										}
+								}
+						#else
+								{
+										taskPOLICY_SELECT();
+								}
+						#endif
+
+						#if ( configUSE_ABORT_ON_MISS == 1 )
+								{
+										while( prvAbortMissedJob( pxCurrentTCB ) != pdFALSE )
+										{
+												taskPOLICY_SELECT();
+										}
+								}
+						#endif
+
+						#if ( configUSE_MK_FIRM == 1 )
+								{
+										/* The job is started when it is first dispatched, from then
+										 * on it can no longer be skipped. */
+										pxCurrentTCB->ucJobStarted = pdTRUE;
+										pxCurrentTCB->ucMKWaiting = pdFALSE;
+								}
+						#endif
+
+						#if ( configUSE_SCHEDULER_STATS == 1 )
+								{
+										if( pxCurrentTCB != pxPreviousTCB )
+										{
+												ulContextSwitchCount++;
+										}
+										else
+										{
+												mtCOVERAGE_TEST_MARKER();
+										}
+								}
+						#endif
 				}
 				#endif
         
         traceTASK_SWITCHED_IN();
 
+        #if ( configUSE_BLOCKING_PROFILER == 1 )
+            {
+                /* Carry on measuring the critical section the task yielded
+                 * from, if it did. */
+                uxBlockingCriticalDepth = pxCurrentTCB->uxBlockingDepth;
+                ulBlockingCriticalSite = pxCurrentTCB->ulBlockingSite;
+                ulBlockingCriticalStart = configBLOCKING_PROFILER_COUNTER_VALUE();
+            }
+        #endif
+
         /* After the new task is switched in, update the global errno. */
         #if ( configUSE_POSIX_ERRNO == 1 )
             {
@@ -3654,6 +8530,18 @@ void vTaskSwitchContext( void )
             }
         #endif /* configUSE_NEWLIB_REENTRANT */
     }
+
+    #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_SCHEDULER_STATS == 1 ) )
+        {
+            ulKernelOverheadTime += ( configBENCHMARK_COUNTER_VALUE() - ulEntryTime );
+        }
+    #endif
+
+    #if ( configUSE_KERNEL_BENCHMARK == 1 )
+        {
+            prvBenchmarkRecord( tskBENCH_SWITCH_CONTEXT, ulBenchmarkStartTime );
+        }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -3665,6 +8553,17 @@ void vTaskPlaceOnEventList( List_t * const pxEventList,
     /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
      * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
 
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        {
+            /* Priorities carry no urgency under EDF, order the waiters by the
+             * policy key of their current job instead (the absolute deadline for
+             * tskPOLICY_EDF).  The value is set on every insertion as the key
+             * changes from job to job.  The top bit is kept clear so the value
+             * is never mistaken for one in use by an event group. */
+            listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( TickType_t ) taskPOLICY_KEY( pxCurrentTCB ) ) & ~( ( TickType_t ) taskEVENT_LIST_ITEM_VALUE_IN_USE ) );
+        }
+    #endif
+
     /* Place the event list item of the TCB in the appropriate event list.
      * This is placed in the list in priority order so the highest priority task
      * is the first to be woken by the event.  The queue that contains the event
@@ -3761,6 +8660,15 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
     if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
     {
         ( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+
+        #if ( configUSE_EDF_SCHEDULER == 1 )
+            {
+                /* The task carries on with its current job, the delayed list
+                 * left its wake time in the item value. */
+                listSET_LIST_ITEM_VALUE( &( pxUnblockedTCB->xStateListItem ), ( TickType_t ) taskPOLICY_KEY( pxUnblockedTCB ) );
+            }
+        #endif
+
         prvAddTaskToReadyList( pxUnblockedTCB );
 
         #if ( configUSE_TICKLESS_IDLE != 0 )
@@ -3784,7 +8692,13 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
         vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
     }
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        /* Compare the keys once the task is in the ready list.  A task held in
+         * the pending ready list is compared by xTaskResumeAll(). */
+        if( ( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE ) && ( taskPOLICY_SHOULD_PREEMPT( pxUnblockedTCB ) != pdFALSE ) )
+    #else
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #endif
     {
         /* Return true if the task removed from the event list has a higher
          * priority than the calling task.  This allows the calling task to know if
@@ -3840,9 +8754,21 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
      * scheduler is suspended so interrupts will not be accessing the ready
      * lists. */
     ( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        {
+            /* The task carries on with its current job. */
+            listSET_LIST_ITEM_VALUE( &( pxUnblockedTCB->xStateListItem ), ( TickType_t ) taskPOLICY_KEY( pxUnblockedTCB ) );
+        }
+    #endif
+
     prvAddTaskToReadyList( pxUnblockedTCB );
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        if( taskPOLICY_SHOULD_PREEMPT( pxUnblockedTCB ) != pdFALSE )
+    #else
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #endif
     {
         /* The unblocked task has a priority above that of the calling task, so
          * a context switch is required.  This function is called with the
@@ -4012,6 +8938,14 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
         /* See if any tasks have deleted themselves - if so then the idle task
          * is responsible for freeing the deleted task's TCB and stack. */
         prvCheckTasksWaitingTermination();
+
+        #if ( configUSE_STACK_PROFILING == 1 )
+            {
+                /* Sample the stacks here rather than on every context switch,
+                 * the idle task only runs when there is time to spare. */
+                prvSampleTaskStacks();
+            }
+        #endif /* configUSE_STACK_PROFILING */
         #if ( configUSE_PREEMPTION == 0 )
             {
                 /* If we are not using preemption we keep forcing a task switch to
@@ -4238,6 +9172,27 @@ static void prvInitialiseTaskLists( void )
 						vListInitialise( &xReadyTasksListEDF );
         }
     #endif
+
+    #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_BUCKETS == 1 ) )
+        {
+            for( uxPriority = ( UBaseType_t ) 0U; uxPriority < tskEDF_BUCKETS; uxPriority++ )
+            {
+                vListInitialise( &( xReadyBucketsEDF[ uxPriority ] ) );
+            }
+        }
+    #endif
+
+    #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_ARRAY == 1 ) )
+        {
+            vListInitialise( &xReadyArrayListEDF );
+        }
+    #endif
+
+    #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_DEFERRED_RELEASES == 1 ) )
+        {
+            vListInitialise( &xPendingReleaseList );
+        }
+    #endif
 				
 
     #if ( INCLUDE_vTaskDelete == 1 )
@@ -4382,63 +9337,202 @@ static void prvCheckTasksWaitingTermination( void )
             pxTaskStatus->usStackHighWaterMark = 0;
         }
     }
-
-#endif /* configUSE_TRACE_FACILITY */
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
+                                                     List_t * pxList,
+                                                     eTaskState eState )
+    {
+        configLIST_VOLATILE TCB_t * pxNextTCB, * pxFirstTCB;
+        UBaseType_t uxTask = 0;
+
+        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        {
+            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            /* Populate an TaskStatus_t structure within the
+             * pxTaskStatusArray array for each task that is referenced from
+             * pxList.  See the definition of TaskStatus_t in task.h for the
+             * meaning of each TaskStatus_t structure member. */
+            do
+            {
+                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
+                uxTask++;
+            } while( pxNextTCB != pxFirstTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxTask;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) || ( configUSE_STACK_PROFILING == 1 ) )
+
+    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+    {
+        uint32_t ulCount = 0U;
+
+        while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+        {
+            pucStackByte -= portSTACK_GROWTH;
+            ulCount++;
+        }
+
+        ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
+
+        return ( configSTACK_DEPTH_TYPE ) ulCount;
+    }
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) || ( configUSE_STACK_PROFILING == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STACK_PROFILING == 1 )
+
+    static void prvStackProfileList( const List_t * pxList )
+    {
+        const ListItem_t * pxEndMarker = listGET_END_MARKER( pxList );
+        ListItem_t * pxIterator;
+        TCB_t * pxTCB;
+        configSTACK_DEPTH_TYPE uxUsed;
+
+        /* Walk the list without moving its index, the ready lists rely on it. */
+        for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            #if ( portSTACK_GROWTH < 0 )
+                {
+                    uxUsed = pxTCB->uxStackDepth - prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
+                }
+            #else
+                {
+                    uxUsed = pxTCB->uxStackDepth - prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
+                }
+            #endif
+
+            if( uxUsed > pxTCB->uxStackUsedMax )
+            {
+                pxTCB->uxStackUsedMax = uxUsed;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
-
-    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
-                                                     List_t * pxList,
-                                                     eTaskState eState )
+    static void prvSampleTaskStacks( void )
     {
-        configLIST_VOLATILE TCB_t * pxNextTCB, * pxFirstTCB;
-        UBaseType_t uxTask = 0;
+        static TickType_t xLastSampleTime = ( TickType_t ) 0U;
 
-        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
-        {
-            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        UBaseType_t uxQueue;
 
-            /* Populate an TaskStatus_t structure within the
-             * pxTaskStatusArray array for each task that is referenced from
-             * pxList.  See the definition of TaskStatus_t in task.h for the
-             * meaning of each TaskStatus_t structure member. */
-            do
+        if( ( xTaskGetTickCount() - xLastSampleTime ) >= configSTACK_PROFILING_PERIOD )
+        {
+            vTaskSuspendAll();
             {
-                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
-                uxTask++;
-            } while( pxNextTCB != pxFirstTCB );
+                xLastSampleTime = xTickCount;
+
+                /* Tasks in xPendingReadyList are also referenced from one of the
+                 * lists below, so it is not walked. */
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    {
+                        for( uxQueue = ( UBaseType_t ) 0U; uxQueue < tskEDF_READY_LISTS; uxQueue++ )
+                        {
+                            prvStackProfileList( taskEDF_READY_LIST( uxQueue ) );
+                        }
+                    }
+                #else
+                    {
+                        for( uxQueue = ( UBaseType_t ) 0U; uxQueue < ( UBaseType_t ) configMAX_PRIORITIES; uxQueue++ )
+                        {
+                            prvStackProfileList( &( pxReadyTasksLists[ uxQueue ] ) );
+                        }
+                    }
+                #endif
+
+                prvStackProfileList( pxDelayedTaskList );
+                prvStackProfileList( pxOverflowDelayedTaskList );
+
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                    {
+                        prvStackProfileList( &xSuspendedTaskList );
+                    }
+                #endif
+            }
+            ( void ) xTaskResumeAll();
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
-
-        return uxTask;
     }
+/*-----------------------------------------------------------*/
 
-#endif /* configUSE_TRACE_FACILITY */
+    configSTACK_DEPTH_TYPE uxTaskGetStackUsedMax( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+
+        /* If xTask is NULL then get the calling task's stack use. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        return pxTCB->uxStackUsedMax;
+    }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+    configSTACK_DEPTH_TYPE uxTaskGetRecommendedStackDepth( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        uint32_t ulDepth;
+
+        /* If xTask is NULL then get the calling task's recommended depth. */
+        pxTCB = prvGetTCBFromHandle( xTask );
 
-    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+        /* The deepest use seen plus configSTACK_PROFILING_MARGIN percent, rounded
+         * up.  Returns 0 until the stack of the task has been sampled. */
+        ulDepth = ( uint32_t ) pxTCB->uxStackUsedMax;
+        ulDepth += ( ( ulDepth * ( uint32_t ) configSTACK_PROFILING_MARGIN ) + 99UL ) / 100UL;
+
+        return ( configSTACK_DEPTH_TYPE ) ulDepth;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskSetStackUsedMax( TaskHandle_t xTask,
+                               configSTACK_DEPTH_TYPE uxStackUsedMax )
     {
-        uint32_t ulCount = 0U;
+        TCB_t * pxTCB;
 
-        while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+        /* Seeds the deepest stack use with the value reported by earlier runs,
+         * so the recommendation covers every run and not only this one. */
+        taskENTER_CRITICAL();
         {
-            pucStackByte -= portSTACK_GROWTH;
-            ulCount++;
-        }
-
-        ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
+            /* If xTask is NULL then set the calling task's stack use. */
+            pxTCB = prvGetTCBFromHandle( xTask );
 
-        return ( configSTACK_DEPTH_TYPE ) ulCount;
+            if( uxStackUsedMax > pxTCB->uxStackUsedMax )
+            {
+                pxTCB->uxStackUsedMax = uxStackUsedMax;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
     }
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
+#endif /* configUSE_STACK_PROFILING */
 /*-----------------------------------------------------------*/
 
 #if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
@@ -4652,15 +9746,18 @@ static void prvResetNextTaskUnblockTime( void )
             {
                 /* Adjust the mutex holder state to account for its new
                  * priority.  Only reset the event list item value if the value is
-                 * not being used for anything else. */
-                if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
-                {
-                    listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                 * not being used for anything else.  Under EDF it holds the
+                 * policy key, see vTaskPlaceOnEventList(). */
+                #if ( configUSE_EDF_SCHEDULER == 0 )
+                    if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+                    {
+                        listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                #endif /* configUSE_EDF_SCHEDULER */
 
                 /* If the task being modified is in the ready state it will need
                  * to be moved into a new list. */
@@ -4761,26 +9858,204 @@ static void prvResetNextTaskUnblockTime( void )
                         mtCOVERAGE_TEST_MARKER();
                     }
 
-                    /* Disinherit the priority before adding the task into the
-                     * new  ready list. */
-                    traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
-                    pxTCB->uxPriority = pxTCB->uxBasePriority;
+                    /* Disinherit the priority before adding the task into the
+                     * new  ready list. */
+                    traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
+                    pxTCB->uxPriority = pxTCB->uxBasePriority;
+
+                    /* Reset the event list item value.  It cannot be in use for
+                     * any other purpose if this task is running, and it must be
+                     * running to give back the mutex.  Under EDF it is set each
+                     * time the task blocks, see vTaskPlaceOnEventList(). */
+                    #if ( configUSE_EDF_SCHEDULER == 0 )
+                        listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    #endif
+                    prvAddTaskToReadyList( pxTCB );
+
+                    /* Return true to indicate that a context switch is required.
+                     * This is only actually required in the corner case whereby
+                     * multiple mutexes were held and the mutexes were given back
+                     * in an order different to that in which they were taken.
+                     * If a context switch did not occur when the first mutex was
+                     * returned, even if a task was waiting on it, then a context
+                     * switch should occur when the last mutex is returned whether
+                     * a task is waiting on it or not. */
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
+                                              UBaseType_t uxHighestPriorityWaitingTask )
+    {
+        TCB_t * const pxTCB = pxMutexHolder;
+        UBaseType_t uxPriorityUsedOnEntry, uxPriorityToUse;
+        const UBaseType_t uxOnlyOneMutexHeld = ( UBaseType_t ) 1;
+
+        if( pxMutexHolder != NULL )
+        {
+            /* If pxMutexHolder is not NULL then the holder must hold at least
+             * one mutex. */
+            configASSERT( pxTCB->uxMutexesHeld );
+
+            /* Determine the priority to which the priority of the task that
+             * holds the mutex should be set.  This will be the greater of the
+             * holding task's base priority and the priority of the highest
+             * priority task that is waiting to obtain the mutex. */
+            if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
+            {
+                uxPriorityToUse = uxHighestPriorityWaitingTask;
+            }
+            else
+            {
+                uxPriorityToUse = pxTCB->uxBasePriority;
+            }
+
+            /* Does the priority need to change? */
+            if( pxTCB->uxPriority != uxPriorityToUse )
+            {
+                /* Only disinherit if no other mutexes are held.  This is a
+                 * simplification in the priority inheritance implementation.  If
+                 * the task that holds the mutex is also holding other mutexes then
+                 * the other mutexes may have caused the priority inheritance. */
+                if( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld )
+                {
+                    /* If a task has timed out because it already holds the
+                     * mutex it was trying to obtain then it cannot of inherited
+                     * its own priority. */
+                    configASSERT( pxTCB != pxCurrentTCB );
+
+                    /* Disinherit the priority, remembering the previous
+                     * priority to facilitate determining the subject task's
+                     * state. */
+                    traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriorityToUse );
+                    uxPriorityUsedOnEntry = pxTCB->uxPriority;
+                    pxTCB->uxPriority = uxPriorityToUse;
+
+                    /* Only reset the event list item value if the value is not
+                     * being used for anything else.  Under EDF the task is still
+                     * waiting on the mutex by its policy key, see
+                     * vTaskPlaceOnEventList(). */
+                    #if ( configUSE_EDF_SCHEDULER == 0 )
+                        if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+                        {
+                            listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    #endif /* configUSE_EDF_SCHEDULER */
+
+                    /* If the running task is not the task that holds the mutex
+                     * then the task that holds the mutex could be in either the
+                     * Ready, Blocked or Suspended states.  Only remove the task
+                     * from its current state list if it is in the Ready state as
+                     * the task's priority is going to change and there is one
+                     * Ready list per priority. */
+                    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                    {
+                        if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                        {
+                            /* It is known that the task is in its ready list so
+                             * there is no need to check again and the port level
+                             * reset macro can be called directly. */
+                            portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        prvAddTaskToReadyList( pxTCB );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+    void vTaskEnterCritical( void )
+    {
+        portDISABLE_INTERRUPTS();
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            ( pxCurrentTCB->uxCriticalNesting )++;
+
+            /* This is not the interrupt safe version of the enter critical
+             * function so  assert() if it is being called from an interrupt
+             * context.  Only API functions that end in "FromISR" can be used in an
+             * interrupt.  Only assert if the critical nesting count is 1 to
+             * protect against recursive calls if the assert function also uses a
+             * critical section. */
+            if( pxCurrentTCB->uxCriticalNesting == 1 )
+            {
+                portASSERT_IF_IN_ISR();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* portCRITICAL_NESTING_IN_TCB */
+/*-----------------------------------------------------------*/
 
-                    /* Reset the event list item value.  It cannot be in use for
-                     * any other purpose if this task is running, and it must be
-                     * running to give back the mutex. */
-                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                    prvAddTaskToReadyList( pxTCB );
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
 
-                    /* Return true to indicate that a context switch is required.
-                     * This is only actually required in the corner case whereby
-                     * multiple mutexes were held and the mutexes were given back
-                     * in an order different to that in which they were taken.
-                     * If a context switch did not occur when the first mutex was
-                     * returned, even if a task was waiting on it, then a context
-                     * switch should occur when the last mutex is returned whether
-                     * a task is waiting on it or not. */
-                    xReturn = pdTRUE;
+    void vTaskExitCritical( void )
+    {
+        if( xSchedulerRunning != pdFALSE )
+        {
+            if( pxCurrentTCB->uxCriticalNesting > 0U )
+            {
+                ( pxCurrentTCB->uxCriticalNesting )--;
+
+                if( pxCurrentTCB->uxCriticalNesting == 0U )
+                {
+                    portENABLE_INTERRUPTS();
                 }
                 else
                 {
@@ -4796,109 +10071,259 @@ static void prvResetNextTaskUnblockTime( void )
         {
             mtCOVERAGE_TEST_MARKER();
         }
+    }
 
-        return xReturn;
+#endif /* portCRITICAL_NESTING_IN_TCB */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+
+    static char * prvWriteNameToBuffer( char * pcBuffer,
+                                        const char * pcTaskName )
+    {
+        size_t x;
+
+        /* Start by copying the entire string. */
+        strcpy( pcBuffer, pcTaskName );
+
+        /* Pad the end of the string with spaces to ensure columns line up when
+         * printed out. */
+        for( x = strlen( pcBuffer ); x < ( size_t ) ( configMAX_TASK_NAME_LEN - 1 ); x++ )
+        {
+            pcBuffer[ x ] = ' ';
+        }
+
+        /* Terminate. */
+        pcBuffer[ x ] = ( char ) 0x00;
+
+        /* Return the new end of string. */
+        return &( pcBuffer[ x ] );
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
-    void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
-                                              UBaseType_t uxHighestPriorityWaitingTask )
+    void vTaskList( char * pcWriteBuffer )
     {
-        TCB_t * const pxTCB = pxMutexHolder;
-        UBaseType_t uxPriorityUsedOnEntry, uxPriorityToUse;
-        const UBaseType_t uxOnlyOneMutexHeld = ( UBaseType_t ) 1;
+        TaskStatus_t * pxTaskStatusArray;
+        UBaseType_t uxArraySize, x;
+        char cStatus;
 
-        if( pxMutexHolder != NULL )
+        /*
+         * PLEASE NOTE:
+         *
+         * This function is provided for convenience only, and is used by many
+         * of the demo applications.  Do not consider it to be part of the
+         * scheduler.
+         *
+         * vTaskList() calls uxTaskGetSystemState(), then formats part of the
+         * uxTaskGetSystemState() output into a human readable table that
+         * displays task names, states and stack usage.
+         *
+         * vTaskList() has a dependency on the sprintf() C library function that
+         * might bloat the code size, use a lot of stack, and provide different
+         * results on different platforms.  An alternative, tiny, third party,
+         * and limited functionality implementation of sprintf() is provided in
+         * many of the FreeRTOS/Demo sub-directories in a file called
+         * printf-stdarg.c (note printf-stdarg.c does not provide a full
+         * snprintf() implementation!).
+         *
+         * It is recommended that production systems call uxTaskGetSystemState()
+         * directly to get access to raw stats data, rather than indirectly
+         * through a call to vTaskList().
+         */
+
+
+        /* Make sure the write buffer does not contain a string. */
+        *pcWriteBuffer = ( char ) 0x00;
+
+        /* Take a snapshot of the number of tasks in case it changes while this
+         * function is executing. */
+        uxArraySize = uxCurrentNumberOfTasks;
+
+        /* Allocate an array index for each task.  NOTE!  if
+         * configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
+         * equate to NULL. */
+        pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+
+        if( pxTaskStatusArray != NULL )
         {
-            /* If pxMutexHolder is not NULL then the holder must hold at least
-             * one mutex. */
-            configASSERT( pxTCB->uxMutexesHeld );
+            /* Generate the (binary) data. */
+            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, NULL );
 
-            /* Determine the priority to which the priority of the task that
-             * holds the mutex should be set.  This will be the greater of the
-             * holding task's base priority and the priority of the highest
-             * priority task that is waiting to obtain the mutex. */
-            if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
+            /* Create a human readable table from the binary data. */
+            for( x = 0; x < uxArraySize; x++ )
             {
-                uxPriorityToUse = uxHighestPriorityWaitingTask;
+                switch( pxTaskStatusArray[ x ].eCurrentState )
+                {
+                    case eRunning:
+                        cStatus = tskRUNNING_CHAR;
+                        break;
+
+                    case eReady:
+                        cStatus = tskREADY_CHAR;
+                        break;
+
+                    case eBlocked:
+                        cStatus = tskBLOCKED_CHAR;
+                        break;
+
+                    case eSuspended:
+                        cStatus = tskSUSPENDED_CHAR;
+                        break;
+
+                    case eDeleted:
+                        cStatus = tskDELETED_CHAR;
+                        break;
+
+                    case eInvalid: /* Fall through. */
+                    default:       /* Should not get here, but it is included
+                                    * to prevent static checking errors. */
+                        cStatus = ( char ) 0x00;
+                        break;
+                }
+
+                /* Write the task name to the string, padding with spaces so it
+                 * can be printed in tabular form more easily. */
+                pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+
+                /* Write the rest of the string. */
+                sprintf( pcWriteBuffer, "\t%c\t%u\t%u\t%u\r\n", cStatus, ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                pcWriteBuffer += strlen( pcWriteBuffer );                                                                                                                                                                                                /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
             }
-            else
+
+            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
+             * is 0 then vPortFree() will be #defined to nothing. */
+            vPortFree( pxTaskStatusArray );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*----------------------------------------------------------*/
+
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    void vTaskGetRunTimeStats( char * pcWriteBuffer )
+    {
+        TaskStatus_t * pxTaskStatusArray;
+        UBaseType_t uxArraySize, x;
+        uint32_t ulTotalTime, ulStatsAsPercentage;
+
+        #if ( configUSE_TRACE_FACILITY != 1 )
             {
-                uxPriorityToUse = pxTCB->uxBasePriority;
+                #error configUSE_TRACE_FACILITY must also be set to 1 in FreeRTOSConfig.h to use vTaskGetRunTimeStats().
             }
+        #endif
 
-            /* Does the priority need to change? */
-            if( pxTCB->uxPriority != uxPriorityToUse )
+        /*
+         * PLEASE NOTE:
+         *
+         * This function is provided for convenience only, and is used by many
+         * of the demo applications.  Do not consider it to be part of the
+         * scheduler.
+         *
+         * vTaskGetRunTimeStats() calls uxTaskGetSystemState(), then formats part
+         * of the uxTaskGetSystemState() output into a human readable table that
+         * displays the amount of time each task has spent in the Running state
+         * in both absolute and percentage terms.
+         *
+         * vTaskGetRunTimeStats() has a dependency on the sprintf() C library
+         * function that might bloat the code size, use a lot of stack, and
+         * provide different results on different platforms.  An alternative,
+         * tiny, third party, and limited functionality implementation of
+         * sprintf() is provided in many of the FreeRTOS/Demo sub-directories in
+         * a file called printf-stdarg.c (note printf-stdarg.c does not provide
+         * a full snprintf() implementation!).
+         *
+         * It is recommended that production systems call uxTaskGetSystemState()
+         * directly to get access to raw stats data, rather than indirectly
+         * through a call to vTaskGetRunTimeStats().
+         */
+
+        /* Make sure the write buffer does not contain a string. */
+        *pcWriteBuffer = ( char ) 0x00;
+
+        /* Take a snapshot of the number of tasks in case it changes while this
+         * function is executing. */
+        uxArraySize = uxCurrentNumberOfTasks;
+
+        /* Allocate an array index for each task.  NOTE!  If
+         * configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
+         * equate to NULL. */
+        pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+
+        if( pxTaskStatusArray != NULL )
+        {
+            /* Generate the (binary) data. */
+            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, &ulTotalTime );
+
+            /* For percentage calculations. */
+            ulTotalTime /= 100UL;
+
+            /* Avoid divide by zero errors. */
+            if( ulTotalTime > 0UL )
             {
-                /* Only disinherit if no other mutexes are held.  This is a
-                 * simplification in the priority inheritance implementation.  If
-                 * the task that holds the mutex is also holding other mutexes then
-                 * the other mutexes may have caused the priority inheritance. */
-                if( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld )
-                {
-                    /* If a task has timed out because it already holds the
-                     * mutex it was trying to obtain then it cannot of inherited
-                     * its own priority. */
-                    configASSERT( pxTCB != pxCurrentTCB );
+                /* Create a human readable table from the binary data. */
+                for( x = 0; x < uxArraySize; x++ )
+                {
+                    /* What percentage of the total run time has the task used?
+                     * This will always be rounded down to the nearest integer.
+                     * ulTotalRunTimeDiv100 has already been divided by 100. */
+                    ulStatsAsPercentage = pxTaskStatusArray[ x ].ulRunTimeCounter / ulTotalTime;
 
-                    /* Disinherit the priority, remembering the previous
-                     * priority to facilitate determining the subject task's
-                     * state. */
-                    traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriorityToUse );
-                    uxPriorityUsedOnEntry = pxTCB->uxPriority;
-                    pxTCB->uxPriority = uxPriorityToUse;
+                    /* Write the task name to the string, padding with
+                     * spaces so it can be printed in tabular form more
+                     * easily. */
+                    pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
 
-                    /* Only reset the event list item value if the value is not
-                     * being used for anything else. */
-                    if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+                    if( ulStatsAsPercentage > 0UL )
                     {
-                        listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
+                            {
+                                sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
+                            }
+                        #else
+                            {
+                                /* sizeof( int ) == sizeof( long ) so a smaller
+                                 * printf() library can be used. */
+                                sprintf( pcWriteBuffer, "\t%u\t\t%u%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned int ) ulStatsAsPercentage ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                            }
+                        #endif
                     }
                     else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        /* If the percentage is zero here then the task has
+                         * consumed less than 1% of the total run time. */
+                        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
+                            {
+                                sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter );
+                            }
+                        #else
+                            {
+                                /* sizeof( int ) == sizeof( long ) so a smaller
+                                 * printf() library can be used. */
+                                sprintf( pcWriteBuffer, "\t%u\t\t<1%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                            }
+                        #endif
                     }
 
-                    /* If the running task is not the task that holds the mutex
-                     * then the task that holds the mutex could be in either the
-                     * Ready, Blocked or Suspended states.  Only remove the task
-                     * from its current state list if it is in the Ready state as
-                     * the task's priority is going to change and there is one
-                     * Ready list per priority. */
-                    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
-                    {
-                        if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                        {
-                            /* It is known that the task is in its ready list so
-                             * there is no need to check again and the port level
-                             * reset macro can be called directly. */
-                            portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-
-                        prvAddTaskToReadyList( pxTCB );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
+                    pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
                 }
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
+
+            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
+             * is 0 then vPortFree() will be #defined to nothing. */
+            vPortFree( pxTaskStatusArray );
         }
         else
         {
@@ -4906,328 +10331,478 @@ static void prvResetNextTaskUnblockTime( void )
         }
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if ( configUSE_KERNEL_BENCHMARK == 1 )
 
-    void vTaskEnterCritical( void )
+    static void prvBenchmarkRecord( UBaseType_t uxPath,
+                                    uint32_t ulStartTime )
     {
-        portDISABLE_INTERRUPTS();
+        BenchmarkPath_t * const pxPath = &( xBenchmarkPaths[ uxPath ] );
+        const uint32_t ulElapsed = configBENCHMARK_COUNTER_VALUE() - ulStartTime;
+        uint32_t ulBucket = ulElapsed / ( uint32_t ) configBENCHMARK_BUCKET_WIDTH;
 
-        if( xSchedulerRunning != pdFALSE )
+        if( ulElapsed < pxPath->ulMin )
         {
-            ( pxCurrentTCB->uxCriticalNesting )++;
+            pxPath->ulMin = ulElapsed;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-            /* This is not the interrupt safe version of the enter critical
-             * function so  assert() if it is being called from an interrupt
-             * context.  Only API functions that end in "FromISR" can be used in an
-             * interrupt.  Only assert if the critical nesting count is 1 to
-             * protect against recursive calls if the assert function also uses a
-             * critical section. */
-            if( pxCurrentTCB->uxCriticalNesting == 1 )
-            {
-                portASSERT_IF_IN_ISR();
-            }
+        if( ulElapsed > pxPath->ulMax )
+        {
+            pxPath->ulMax = ulElapsed;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The last bucket counts everything that is too long for the others. */
+        if( ulBucket >= ( uint32_t ) configBENCHMARK_BUCKETS )
+        {
+            ulBucket = ( uint32_t ) configBENCHMARK_BUCKETS - 1UL;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
+
+        ( pxPath->ulBuckets[ ulBucket ] )++;
+        pxPath->ulTotal += ulElapsed;
+        ( pxPath->ulCount )++;
     }
+/*-----------------------------------------------------------*/
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+    void vTaskResetKernelPathStats( void )
+    {
+        UBaseType_t uxPath, x;
+
+        taskENTER_CRITICAL();
+        {
+            for( uxPath = ( UBaseType_t ) 0U; uxPath < ( UBaseType_t ) tskBENCH_NUMBER_OF_PATHS; uxPath++ )
+            {
+                xBenchmarkPaths[ uxPath ].ulMin = 0xffffffffUL;
+                xBenchmarkPaths[ uxPath ].ulMax = 0UL;
+                xBenchmarkPaths[ uxPath ].ulTotal = 0UL;
+                xBenchmarkPaths[ uxPath ].ulCount = 0UL;
+
+                for( x = ( UBaseType_t ) 0U; x < ( UBaseType_t ) configBENCHMARK_BUCKETS; x++ )
+                {
+                    xBenchmarkPaths[ uxPath ].ulBuckets[ x ] = 0UL;
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+    #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
-    void vTaskExitCritical( void )
-    {
-        if( xSchedulerRunning != pdFALSE )
+        void vTaskGetKernelPathStats( char * pcWriteBuffer,
+                                      size_t uxBufferLength )
         {
-            if( pxCurrentTCB->uxCriticalNesting > 0U )
+            static const char * const pcPathNames[ tskBENCH_NUMBER_OF_PATHS ] = { "Switch", "Tick", "DelayUntil", "Create" };
+            BenchmarkPath_t xPath;
+            UBaseType_t uxPath, uxTasks;
+            uint32_t ulSeen, ulP99, ulAverage;
+            UBaseType_t x;
+            size_t uxConsumed;
+            int iWritten;
+
+            /*
+             * PLEASE NOTE:
+             *
+             * This function is provided for convenience only, like
+             * vTaskGetRunTimeStats() it depends on snprintf().
+             *
+             * Writes one line per kernel path with the minimum, average, maximum
+             * and 99th percentile duration, in configBENCHMARK_COUNTER_VALUE()
+             * counts, of the calls since the last vTaskResetKernelPathStats().
+             * The number of tasks is written first as the durations depend on it.
+             * The percentile is the upper bound of its histogram bucket.
+             *
+             * At most uxBufferLength characters, including the terminating
+             * null, are written.  The output is cut short if they do not fit,
+             * about 250 characters are needed when every count has 10 digits.
+             */
+
+            configASSERT( uxBufferLength > 0U );
+
+            uxTasks = uxCurrentNumberOfTasks;
+            iWritten = snprintf( pcWriteBuffer, uxBufferLength, "Tasks %u\r\n", ( unsigned int ) uxTasks ); /*lint !e586 snprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+            uxConsumed = prvSnprintfReturnValueToCharsWritten( iWritten, uxBufferLength );
+
+            for( uxPath = ( UBaseType_t ) 0U; uxPath < ( UBaseType_t ) tskBENCH_NUMBER_OF_PATHS; uxPath++ )
             {
-                ( pxCurrentTCB->uxCriticalNesting )--;
+                /* Take a consistent copy, the paths keep being recorded. */
+                taskENTER_CRITICAL();
+                {
+                    xPath = xBenchmarkPaths[ uxPath ];
+                }
+                taskEXIT_CRITICAL();
 
-                if( pxCurrentTCB->uxCriticalNesting == 0U )
+                if( xPath.ulCount > 0UL )
                 {
-                    portENABLE_INTERRUPTS();
+                    ulAverage = xPath.ulTotal / xPath.ulCount;
+
+                    /* Find the bucket in which the 99th percentile falls. */
+                    ulSeen = 0UL;
+                    ulP99 = xPath.ulMax;
+
+                    for( x = ( UBaseType_t ) 0U; x < ( UBaseType_t ) ( configBENCHMARK_BUCKETS - 1 ); x++ )
+                    {
+                        ulSeen += xPath.ulBuckets[ x ];
+
+                        if( ( ulSeen * 100UL ) >= ( xPath.ulCount * 99UL ) )
+                        {
+                            ulP99 = ( ( ( uint32_t ) x + 1UL ) * ( uint32_t ) configBENCHMARK_BUCKET_WIDTH ) - 1UL;
+                            break;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+
+                    if( ulP99 > xPath.ulMax )
+                    {
+                        ulP99 = xPath.ulMax;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    iWritten = snprintf( &( pcWriteBuffer[ uxConsumed ] ), uxBufferLength - uxConsumed, "%s\t%u\t%u\t%u\t%u\r\n", pcPathNames[ uxPath ], ( unsigned int ) xPath.ulMin, ( unsigned int ) ulAverage, ( unsigned int ) xPath.ulMax, ( unsigned int ) ulP99 ); /*lint !e586 snprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    iWritten = snprintf( &( pcWriteBuffer[ uxConsumed ] ), uxBufferLength - uxConsumed, "%s\t-\r\n", pcPathNames[ uxPath ] ); /*lint !e586 snprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
                 }
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
+
+                uxConsumed += prvSnprintfReturnValueToCharsWritten( iWritten, uxBufferLength - uxConsumed );
             }
         }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-    }
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+    #endif /* configUSE_STATS_FORMATTING_FUNCTIONS */
+
+#endif /* configUSE_KERNEL_BENCHMARK */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+#if ( ( ( configUSE_KERNEL_BENCHMARK == 1 ) || ( configUSE_BLOCKING_PROFILER == 1 ) ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
-    static char * prvWriteNameToBuffer( char * pcBuffer,
-                                        const char * pcTaskName )
+    static size_t prvSnprintfReturnValueToCharsWritten( int iSnprintfReturnValue,
+                                                        size_t uxBufferLength )
     {
-        size_t x;
-
-        /* Start by copying the entire string. */
-        strcpy( pcBuffer, pcTaskName );
+        size_t uxCharsWritten;
 
-        /* Pad the end of the string with spaces to ensure columns line up when
-         * printed out. */
-        for( x = strlen( pcBuffer ); x < ( size_t ) ( configMAX_TASK_NAME_LEN - 1 ); x++ )
+        if( iSnprintfReturnValue < 0 )
         {
-            pcBuffer[ x ] = ' ';
+            /* An encoding error, nothing is counted as written. */
+            uxCharsWritten = 0;
+        }
+        else if( ( size_t ) iSnprintfReturnValue >= uxBufferLength )
+        {
+            /* The output was truncated to fill the buffer. */
+            uxCharsWritten = ( uxBufferLength > 0U ) ? ( uxBufferLength - 1U ) : 0U;
+        }
+        else
+        {
+            uxCharsWritten = ( size_t ) iSnprintfReturnValue;
         }
 
-        /* Terminate. */
-        pcBuffer[ x ] = ( char ) 0x00;
-
-        /* Return the new end of string. */
-        return &( pcBuffer[ x ] );
+        return uxCharsWritten;
     }
 
-#endif /* ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) */
+#endif /* configUSE_STATS_FORMATTING_FUNCTIONS */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+#if ( configUSE_BLOCKING_PROFILER == 1 )
 
-    void vTaskList( char * pcWriteBuffer )
+    static void prvBlockingRecord( UBaseType_t uxKind,
+                                   uint32_t ulStartTime,
+                                   uint32_t ulSite )
     {
-        TaskStatus_t * pxTaskStatusArray;
-        UBaseType_t uxArraySize, x;
-        char cStatus;
-
-        /*
-         * PLEASE NOTE:
-         *
-         * This function is provided for convenience only, and is used by many
-         * of the demo applications.  Do not consider it to be part of the
-         * scheduler.
-         *
-         * vTaskList() calls uxTaskGetSystemState(), then formats part of the
-         * uxTaskGetSystemState() output into a human readable table that
-         * displays task names, states and stack usage.
-         *
-         * vTaskList() has a dependency on the sprintf() C library function that
-         * might bloat the code size, use a lot of stack, and provide different
-         * results on different platforms.  An alternative, tiny, third party,
-         * and limited functionality implementation of sprintf() is provided in
-         * many of the FreeRTOS/Demo sub-directories in a file called
-         * printf-stdarg.c (note printf-stdarg.c does not provide a full
-         * snprintf() implementation!).
-         *
-         * It is recommended that production systems call uxTaskGetSystemState()
-         * directly to get access to raw stats data, rather than indirectly
-         * through a call to vTaskList().
-         */
-
-
-        /* Make sure the write buffer does not contain a string. */
-        *pcWriteBuffer = ( char ) 0x00;
-
-        /* Take a snapshot of the number of tasks in case it changes while this
-         * function is executing. */
-        uxArraySize = uxCurrentNumberOfTasks;
-
-        /* Allocate an array index for each task.  NOTE!  if
-         * configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
-         * equate to NULL. */
-        pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+        BlockingKind_t * const pxKind = &( xBlockingKinds[ uxKind ] );
+        const uint32_t ulElapsed = configBLOCKING_PROFILER_COUNTER_VALUE() - ulStartTime;
+        BlockingSite_t * pxSite = NULL;
+        BlockingSite_t * pxFree = NULL;
+        BlockingSite_t * pxShortest = &( pxKind->xSites[ 0 ] );
+        uint32_t ulBucket = 0UL, ulRemaining;
+        UBaseType_t x;
 
-        if( pxTaskStatusArray != NULL )
+        if( ulElapsed > pxKind->ulMax )
         {
-            /* Generate the (binary) data. */
-            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, NULL );
-
-            /* Create a human readable table from the binary data. */
-            for( x = 0; x < uxArraySize; x++ )
-            {
-                switch( pxTaskStatusArray[ x ].eCurrentState )
-                {
-                    case eRunning:
-                        cStatus = tskRUNNING_CHAR;
-                        break;
-
-                    case eReady:
-                        cStatus = tskREADY_CHAR;
-                        break;
+            pxKind->ulMax = ulElapsed;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-                    case eBlocked:
-                        cStatus = tskBLOCKED_CHAR;
-                        break;
+        /* The bucket is the number of significant bits in the duration. */
+        for( ulRemaining = ulElapsed; ulRemaining != 0UL; ulRemaining >>= 1 )
+        {
+            ulBucket++;
+        }
 
-                    case eSuspended:
-                        cStatus = tskSUSPENDED_CHAR;
-                        break;
+        /* The last bucket counts everything that is too long for the others. */
+        if( ulBucket >= ( uint32_t ) configBLOCKING_PROFILER_BUCKETS )
+        {
+            ulBucket = ( uint32_t ) configBLOCKING_PROFILER_BUCKETS - 1UL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-                    case eDeleted:
-                        cStatus = tskDELETED_CHAR;
-                        break;
+        ( pxKind->ulBuckets[ ulBucket ] )++;
+        pxKind->ulTotal += ulElapsed;
+        ( pxKind->ulCount )++;
 
-                    case eInvalid: /* Fall through. */
-                    default:       /* Should not get here, but it is included
-                                    * to prevent static checking errors. */
-                        cStatus = ( char ) 0x00;
-                        break;
+        /* Find the entry of the site, or a free one, or else the entry with
+         * the shortest longest section, which this section takes over if it is
+         * longer. */
+        for( x = ( UBaseType_t ) 0U; x < ( UBaseType_t ) configBLOCKING_PROFILER_SITES; x++ )
+        {
+            if( pxKind->xSites[ x ].ulCount == 0UL )
+            {
+                if( pxFree == NULL )
+                {
+                    pxFree = &( pxKind->xSites[ x ] );
                 }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else if( pxKind->xSites[ x ].ulSite == ulSite )
+            {
+                pxSite = &( pxKind->xSites[ x ] );
+                break;
+            }
+            else if( pxKind->xSites[ x ].ulMax < pxShortest->ulMax )
+            {
+                pxShortest = &( pxKind->xSites[ x ] );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
 
-                /* Write the task name to the string, padding with spaces so it
-                 * can be printed in tabular form more easily. */
-                pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
-
-                /* Write the rest of the string. */
-                sprintf( pcWriteBuffer, "\t%c\t%u\t%u\t%u\r\n", cStatus, ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
-                pcWriteBuffer += strlen( pcWriteBuffer );                                                                                                                                                                                                /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+        if( pxSite == NULL )
+        {
+            if( pxFree != NULL )
+            {
+                pxSite = pxFree;
+            }
+            else if( ulElapsed > pxShortest->ulMax )
+            {
+                pxSite = pxShortest;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
 
-            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
-             * is 0 then vPortFree() will be #defined to nothing. */
-            vPortFree( pxTaskStatusArray );
+            if( pxSite != NULL )
+            {
+                pxSite->ulSite = ulSite;
+                pxSite->ulMax = 0UL;
+                pxSite->ulCount = 0UL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
-    }
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
-/*----------------------------------------------------------*/
+        if( pxSite != NULL )
+        {
+            if( ulElapsed > pxSite->ulMax )
+            {
+                pxSite->ulMax = ulElapsed;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+            ( pxSite->ulCount )++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
 
-    void vTaskGetRunTimeStats( char * pcWriteBuffer )
+    static void prvBlockingCriticalEnter( uint32_t ulSite )
     {
-        TaskStatus_t * pxTaskStatusArray;
-        UBaseType_t uxArraySize, x;
-        uint32_t ulTotalTime, ulStatsAsPercentage;
-
-        #if ( configUSE_TRACE_FACILITY != 1 )
-            {
-                #error configUSE_TRACE_FACILITY must also be set to 1 in FreeRTOSConfig.h to use vTaskGetRunTimeStats().
-            }
-        #endif
+        if( uxBlockingCriticalDepth == ( UBaseType_t ) 0U )
+        {
+            ulBlockingCriticalStart = configBLOCKING_PROFILER_COUNTER_VALUE();
+            ulBlockingCriticalSite = ulSite;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        /*
-         * PLEASE NOTE:
-         *
-         * This function is provided for convenience only, and is used by many
-         * of the demo applications.  Do not consider it to be part of the
-         * scheduler.
-         *
-         * vTaskGetRunTimeStats() calls uxTaskGetSystemState(), then formats part
-         * of the uxTaskGetSystemState() output into a human readable table that
-         * displays the amount of time each task has spent in the Running state
-         * in both absolute and percentage terms.
-         *
-         * vTaskGetRunTimeStats() has a dependency on the sprintf() C library
-         * function that might bloat the code size, use a lot of stack, and
-         * provide different results on different platforms.  An alternative,
-         * tiny, third party, and limited functionality implementation of
-         * sprintf() is provided in many of the FreeRTOS/Demo sub-directories in
-         * a file called printf-stdarg.c (note printf-stdarg.c does not provide
-         * a full snprintf() implementation!).
-         *
-         * It is recommended that production systems call uxTaskGetSystemState()
-         * directly to get access to raw stats data, rather than indirectly
-         * through a call to vTaskGetRunTimeStats().
-         */
+        uxBlockingCriticalDepth++;
+    }
+/*-----------------------------------------------------------*/
 
-        /* Make sure the write buffer does not contain a string. */
-        *pcWriteBuffer = ( char ) 0x00;
+    static void prvBlockingCriticalExit( void )
+    {
+        configASSERT( uxBlockingCriticalDepth );
 
-        /* Take a snapshot of the number of tasks in case it changes while this
-         * function is executing. */
-        uxArraySize = uxCurrentNumberOfTasks;
+        uxBlockingCriticalDepth--;
 
-        /* Allocate an array index for each task.  NOTE!  If
-         * configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
-         * equate to NULL. */
-        pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+        if( uxBlockingCriticalDepth == ( UBaseType_t ) 0U )
+        {
+            prvBlockingRecord( tskBLOCK_INTERRUPTS_MASKED, ulBlockingCriticalStart, ulBlockingCriticalSite );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
 
-        if( pxTaskStatusArray != NULL )
+    void vTaskResetBlockingStats( void )
+    {
+        taskENTER_CRITICAL();
         {
-            /* Generate the (binary) data. */
-            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, &ulTotalTime );
+            ( void ) memset( ( void * ) xBlockingKinds, 0x00, sizeof( xBlockingKinds ) );
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
 
-            /* For percentage calculations. */
-            ulTotalTime /= 100UL;
+    #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
-            /* Avoid divide by zero errors. */
-            if( ulTotalTime > 0UL )
+        void vTaskGetBlockingStats( char * pcWriteBuffer,
+                                    size_t uxBufferLength )
+        {
+            static const char * const pcKindNames[ tskBLOCK_NUMBER_OF_KINDS ] = { "Masked", "Suspended" };
+            BlockingKind_t xKind;
+            UBaseType_t uxKind, x;
+            uint32_t ulSeen, ulP99, ulAverage;
+            size_t uxConsumed = 0U;
+            int iWritten;
+
+            /*
+             * PLEASE NOTE:
+             *
+             * This function is provided for convenience only, like
+             * vTaskGetRunTimeStats() it depends on snprintf().
+             *
+             * Writes one line per kind of blocking with the number of sections
+             * and their average, maximum and 99th percentile duration, in
+             * configBLOCKING_PROFILER_COUNTER_VALUE() counts, since the last
+             * vTaskResetBlockingStats().  Then one line for each of the
+             * sites with the longest sections, giving that site's longest
+             * section and number of sections.  Critical sections are
+             * given by their line in tasks.c, "Tick" is the tick handler, and
+             * scheduler suspensions by the address vTaskSuspendAll() returned
+             * to.  The percentile is the upper bound of its histogram bucket.
+             *
+             * At most uxBufferLength characters, including the terminating
+             * null, are written.  The output is cut short if they do not fit,
+             * about 400 characters are needed when every count has 10 digits.
+             */
+
+            configASSERT( uxBufferLength > 0U );
+
+            *pcWriteBuffer = ( char ) 0x00;
+
+            for( uxKind = ( UBaseType_t ) 0U; uxKind < ( UBaseType_t ) tskBLOCK_NUMBER_OF_KINDS; uxKind++ )
             {
-                /* Create a human readable table from the binary data. */
-                for( x = 0; x < uxArraySize; x++ )
+                /* Take a consistent copy, the sections keep being recorded. */
+                taskENTER_CRITICAL();
                 {
-                    /* What percentage of the total run time has the task used?
-                     * This will always be rounded down to the nearest integer.
-                     * ulTotalRunTimeDiv100 has already been divided by 100. */
-                    ulStatsAsPercentage = pxTaskStatusArray[ x ].ulRunTimeCounter / ulTotalTime;
+                    xKind = xBlockingKinds[ uxKind ];
+                }
+                taskEXIT_CRITICAL();
 
-                    /* Write the task name to the string, padding with
-                     * spaces so it can be printed in tabular form more
-                     * easily. */
-                    pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+                if( xKind.ulCount > 0UL )
+                {
+                    ulAverage = xKind.ulTotal / xKind.ulCount;
 
-                    if( ulStatsAsPercentage > 0UL )
+                    /* Find the bucket in which the 99th percentile falls. */
+                    ulSeen = 0UL;
+                    ulP99 = xKind.ulMax;
+
+                    for( x = ( UBaseType_t ) 0U; x < ( UBaseType_t ) ( configBLOCKING_PROFILER_BUCKETS - 1 ); x++ )
                     {
-                        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
-                            {
-                                sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
-                            }
-                        #else
-                            {
-                                /* sizeof( int ) == sizeof( long ) so a smaller
-                                 * printf() library can be used. */
-                                sprintf( pcWriteBuffer, "\t%u\t\t%u%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned int ) ulStatsAsPercentage ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
-                            }
-                        #endif
+                        ulSeen += xKind.ulBuckets[ x ];
+
+                        if( ( ulSeen * 100UL ) >= ( xKind.ulCount * 99UL ) )
+                        {
+                            ulP99 = ( 1UL << x ) - 1UL;
+                            break;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+
+                    if( ulP99 > xKind.ulMax )
+                    {
+                        ulP99 = xKind.ulMax;
                     }
                     else
                     {
-                        /* If the percentage is zero here then the task has
-                         * consumed less than 1% of the total run time. */
-                        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
-                            {
-                                sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter );
-                            }
-                        #else
-                            {
-                                /* sizeof( int ) == sizeof( long ) so a smaller
-                                 * printf() library can be used. */
-                                sprintf( pcWriteBuffer, "\t%u\t\t<1%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
-                            }
-                        #endif
+                        mtCOVERAGE_TEST_MARKER();
                     }
 
-                    pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+                    iWritten = snprintf( &( pcWriteBuffer[ uxConsumed ] ), uxBufferLength - uxConsumed, "%s\t%u\t%u\t%u\t%u\r\n", pcKindNames[ uxKind ], ( unsigned int ) xKind.ulCount, ( unsigned int ) ulAverage, ( unsigned int ) xKind.ulMax, ( unsigned int ) ulP99 ); /*lint !e586 snprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                    uxConsumed += prvSnprintfReturnValueToCharsWritten( iWritten, uxBufferLength - uxConsumed );
+
+                    for( x = ( UBaseType_t ) 0U; x < ( UBaseType_t ) configBLOCKING_PROFILER_SITES; x++ )
+                    {
+                        if( xKind.xSites[ x ].ulCount == 0UL )
+                        {
+                            iWritten = 0;
+                        }
+                        else if( uxKind == ( UBaseType_t ) tskBLOCK_SCHEDULER_SUSPENDED )
+                        {
+                            iWritten = snprintf( &( pcWriteBuffer[ uxConsumed ] ), uxBufferLength - uxConsumed, " 0x%x\t%u\t%u\r\n", ( unsigned int ) xKind.xSites[ x ].ulSite, ( unsigned int ) xKind.xSites[ x ].ulMax, ( unsigned int ) xKind.xSites[ x ].ulCount ); /*lint !e586 snprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                        }
+                        else if( xKind.xSites[ x ].ulSite == tskBLOCK_SITE_TICK )
+                        {
+                            iWritten = snprintf( &( pcWriteBuffer[ uxConsumed ] ), uxBufferLength - uxConsumed, " Tick\t%u\t%u\r\n", ( unsigned int ) xKind.xSites[ x ].ulMax, ( unsigned int ) xKind.xSites[ x ].ulCount ); /*lint !e586 snprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                        }
+                        else
+                        {
+                            iWritten = snprintf( &( pcWriteBuffer[ uxConsumed ] ), uxBufferLength - uxConsumed, " L%u\t%u\t%u\r\n", ( unsigned int ) xKind.xSites[ x ].ulSite, ( unsigned int ) xKind.xSites[ x ].ulMax, ( unsigned int ) xKind.xSites[ x ].ulCount ); /*lint !e586 snprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                        }
+
+                        uxConsumed += prvSnprintfReturnValueToCharsWritten( iWritten, uxBufferLength - uxConsumed );
+                    }
+                }
+                else
+                {
+                    iWritten = snprintf( &( pcWriteBuffer[ uxConsumed ] ), uxBufferLength - uxConsumed, "%s\t-\r\n", pcKindNames[ uxKind ] ); /*lint !e586 snprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                    uxConsumed += prvSnprintfReturnValueToCharsWritten( iWritten, uxBufferLength - uxConsumed );
                 }
             }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-
-            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
-             * is 0 then vPortFree() will be #defined to nothing. */
-            vPortFree( pxTaskStatusArray );
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
         }
-    }
 
-#endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+    #endif /* configUSE_STATS_FORMATTING_FUNCTIONS */
+
+#endif /* configUSE_BLOCKING_PROFILER */
 /*-----------------------------------------------------------*/
 
 TickType_t uxTaskResetEventItemValue( void )
@@ -5497,6 +11072,15 @@ TickType_t uxTaskResetEventItemValue( void )
             if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
             {
                 ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    {
+                        /* The task carries on with its current job, the delayed
+                         * list left its wake time in the item value. */
+                        listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), ( TickType_t ) taskPOLICY_KEY( pxTCB ) );
+                    }
+                #endif
+
                 prvAddTaskToReadyList( pxTCB );
 
                 /* The task should not have been on an event list. */
@@ -5518,7 +11102,11 @@ TickType_t uxTaskResetEventItemValue( void )
                     }
                 #endif
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    if( taskPOLICY_SHOULD_PREEMPT( pxTCB ) != pdFALSE )
+                #else
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #endif
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5644,6 +11232,15 @@ TickType_t uxTaskResetEventItemValue( void )
                 if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
                 {
                     ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+                    #if ( configUSE_EDF_SCHEDULER == 1 )
+                        {
+                            /* The task carries on with its current job, the
+                             * delayed list left its wake time in the item value. */
+                            listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), ( TickType_t ) taskPOLICY_KEY( pxTCB ) );
+                        }
+                    #endif
+
                     prvAddTaskToReadyList( pxTCB );
                 }
                 else
@@ -5653,7 +11250,13 @@ TickType_t uxTaskResetEventItemValue( void )
                     vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    /* A task held in the pending ready list is compared by
+                     * xTaskResumeAll(). */
+                    if( ( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE ) && ( taskPOLICY_SHOULD_PREEMPT( pxTCB ) != pdFALSE ) )
+                #else
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #endif
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5735,6 +11338,15 @@ TickType_t uxTaskResetEventItemValue( void )
                 if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
                 {
                     ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+                    #if ( configUSE_EDF_SCHEDULER == 1 )
+                        {
+                            /* The task carries on with its current job, the
+                             * delayed list left its wake time in the item value. */
+                            listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), ( TickType_t ) taskPOLICY_KEY( pxTCB ) );
+                        }
+                    #endif
+
                     prvAddTaskToReadyList( pxTCB );
                 }
                 else
@@ -5744,7 +11356,13 @@ TickType_t uxTaskResetEventItemValue( void )
                     vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    /* A task held in the pending ready list is compared by
+                     * xTaskResumeAll(). */
+                    if( ( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE ) && ( taskPOLICY_SHOULD_PREEMPT( pxTCB ) != pdFALSE ) )
+                #else
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #endif
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
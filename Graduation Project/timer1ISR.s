@@ -0,0 +1,25 @@
+	INCLUDE portmacro.inc
+
+	IMPORT	vTimer1ISRHandler
+	EXPORT	vTimer1ISREntry
+
+	;/* Timer 1 interrupt entry point.  The task context is saved before the
+	;handler runs as it may release a task that preempts the interrupted one. */
+
+	ARM
+	AREA	|.text|, CODE, READONLY
+
+vTimer1ISREntry
+
+	PRESERVE8
+
+	; Save the context of the interrupted task.
+	portSAVE_CONTEXT
+
+	; Call the C handler, which calls vTaskSwitchContext() if required.
+	BL	vTimer1ISRHandler
+
+	; Restore the context of the task selected to execute.
+	portRESTORE_CONTEXT
+
+	END
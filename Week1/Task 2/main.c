@@ -84,44 +84,152 @@ static void prvSetupHardware( void );
 /*-----------------------------------------------------------*/
 
 
-TaskHandle_t Task1Handler = NULL;
-TaskHandle_t Task2Handler = NULL;
-TaskHandle_t Task3Handler = NULL;
+/* Periodic actions: small callbacks that run to completion, one after the
+other, from the single Actions task in the order of their next fire time.
+They replace a task (stack and TCB) per blinking LED. */
+#define mainMAX_PERIODIC_ACTIONS	( 16 )
+#define mainACTIONS_STACK_SIZE		( 100 )
+#define mainACTIONS_PRIORITY		( 1 )
 
+typedef void ( * PeriodicActionFunction_t )( void * pvParameters );
+
+typedef struct
+{
+	PeriodicActionFunction_t pxAction;	/* Called every xPeriod ticks, must not block. */
+	void * pvParameters;				/* Passed to pxAction. */
+	TickType_t xPeriod;					/* Ticks between two calls. */
+	TickType_t xNextFireTime;			/* Tick count of the next call. */
+} PeriodicAction_t;
+
+/* Binary min-heap on xNextFireTime, the next action to run is always xActions[ 0 ]. */
+static PeriodicAction_t xActions[ mainMAX_PERIODIC_ACTIONS ];
+static UBaseType_t uxActionCount = 0;
+
+/* An LED blinked by a periodic action. */
+typedef struct
+{
+	int iPin;		/* Pin of PORT_0 the LED is on. */
+	int iState;		/* Current level of the pin. */
+} BlinkLed_t;
+
+static BlinkLed_t xLeds[ 3 ] =
+{
+	{ PIN0, 0 },	/* 100ms on, 100ms off. */
+	{ PIN1, 0 },	/* 500ms on, 500ms off. */
+	{ PIN2, 0 }		/* 1000ms on, 1000ms off. */
+};
+
+static BaseType_t xPeriodicActionRegister( PeriodicActionFunction_t pxAction, void * pvParameters, TickType_t xPeriod );
+static void prvPeriodicActionsTask( void * pvParameters );
 
 
 
-/* Task to be created. */
+/* True if the action at uxA fires before the action at uxB, the difference
+is signed so the comparison still holds when the tick count wraps. */
+#define prvACTION_FIRES_BEFORE( uxA, uxB ) \
+	( ( BaseType_t ) ( xActions[ ( uxA ) ].xNextFireTime - xActions[ ( uxB ) ].xNextFireTime ) < 0 )
 
-void Task1( void * pvParameters )
+static void prvActionSwap( UBaseType_t uxA, UBaseType_t uxB )
 {
-    for( ;; )
-    {
-      GPIO_write(PORT_0,PIN0,PIN_IS_HIGH);
-			vTaskDelay(100);
-			GPIO_write(PORT_0,PIN0,PIN_IS_LOW);
-			vTaskDelay(100);
-    }
+	PeriodicAction_t xTemp = xActions[ uxA ];
+
+	xActions[ uxA ] = xActions[ uxB ];
+	xActions[ uxB ] = xTemp;
+}
+
+/* Must be called before the scheduler is started, the heap is not protected. */
+static BaseType_t xPeriodicActionRegister( PeriodicActionFunction_t pxAction, void * pvParameters, TickType_t xPeriod )
+{
+	UBaseType_t uxIndex;
+
+	if( ( uxActionCount >= mainMAX_PERIODIC_ACTIONS ) || ( xPeriod == 0 ) )
+	{
+		return pdFAIL;
+	}
+
+	uxIndex = uxActionCount++;
+	xActions[ uxIndex ].pxAction = pxAction;
+	xActions[ uxIndex ].pvParameters = pvParameters;
+	xActions[ uxIndex ].xPeriod = xPeriod;
+	xActions[ uxIndex ].xNextFireTime = xTaskGetTickCount();
+
+	/* Move the new action up to its place in the heap. */
+	while( ( uxIndex > 0 ) && prvACTION_FIRES_BEFORE( uxIndex, ( uxIndex - 1 ) / 2 ) )
+	{
+		prvActionSwap( uxIndex, ( uxIndex - 1 ) / 2 );
+		uxIndex = ( uxIndex - 1 ) / 2;
+	}
+
+	return pdPASS;
 }
-void Task2( void * pvParameters )
+
+/* Move the root down to its place after its fire time was moved on. */
+static void prvActionSiftDown( void )
 {
-    for( ;; )
-    {
-      GPIO_write(PORT_0,PIN1,PIN_IS_HIGH);
-			vTaskDelay(500);
-			GPIO_write(PORT_0,PIN1,PIN_IS_LOW);
-			vTaskDelay(500);
-    }
+	UBaseType_t uxIndex = 0, uxChild;
+
+	for( ;; )
+	{
+		uxChild = ( 2 * uxIndex ) + 1;
+
+		if( uxChild >= uxActionCount )
+		{
+			break;
+		}
+
+		if( ( ( uxChild + 1 ) < uxActionCount ) && prvACTION_FIRES_BEFORE( uxChild + 1, uxChild ) )
+		{
+			uxChild++;
+		}
+
+		if( !prvACTION_FIRES_BEFORE( uxChild, uxIndex ) )
+		{
+			break;
+		}
+
+		prvActionSwap( uxIndex, uxChild );
+		uxIndex = uxChild;
+	}
 }
-void Task3( void * pvParameters )
+
+/* The one task all the actions run from, on its stack. */
+static void prvPeriodicActionsTask( void * pvParameters )
 {
-    for( ;; )
-    {
-      GPIO_write(PORT_0,PIN2,PIN_IS_HIGH);
-			vTaskDelay(1000);
-			GPIO_write(PORT_0,PIN2,PIN_IS_LOW);
-			vTaskDelay(1000);
-    }
+	TickType_t xNow;
+
+	for( ;; )
+	{
+		xNow = xTaskGetTickCount();
+
+		if( uxActionCount == 0 )
+		{
+			/* Nothing was registered, xActions[ 0 ] is not valid. */
+			vTaskDelay( portMAX_DELAY );
+		}
+		else if( ( BaseType_t ) ( xActions[ 0 ].xNextFireTime - xNow ) > 0 )
+		{
+			/* Sleep until the earliest action is due. */
+			vTaskDelay( xActions[ 0 ].xNextFireTime - xNow );
+		}
+		else
+		{
+			/* Run the due action.  Its next fire time is kept on its own grid
+			so the period does not drift with the time the action takes. */
+			xActions[ 0 ].pxAction( xActions[ 0 ].pvParameters );
+			xActions[ 0 ].xNextFireTime += xActions[ 0 ].xPeriod;
+			prvActionSiftDown();
+		}
+	}
+}
+
+/* Action to be registered. */
+
+void BlinkAction( void * pvParameters )
+{
+	BlinkLed_t * pxLed = ( BlinkLed_t * ) pvParameters;
+
+	pxLed->iState = !pxLed->iState;
+	GPIO_write(PORT_0,pxLed->iPin,(pxLed->iState ? PIN_IS_HIGH : PIN_IS_LOW));
 }
 
 
@@ -135,29 +243,20 @@ int main( void )
 	prvSetupHardware();
 
 	
-    /* Create Tasks here */
-	 xTaskCreate(
-                    Task1,       /* Function that implements the task. */
-                    "Task1",          /* Text name for the task. */
-                    100,      /* Stack size in words, not bytes. */
-                    ( void * ) 0,    /* Parameter passed into the task. */
-                    1,/* Priority at which the task is created. */
-                    &Task1Handler );      /* Used to pass out the created task's handle. */
+    /* Register the actions here, each toggles its LED once per period (in ticks), so the LED blinks with twice that period */
+	xPeriodicActionRegister( BlinkAction, &xLeds[ 0 ], 100 );
+	xPeriodicActionRegister( BlinkAction, &xLeds[ 1 ], 500 );
+	xPeriodicActionRegister( BlinkAction, &xLeds[ 2 ], 1000 );
+
+    /* Create the task that runs them */
 	 xTaskCreate(
-                    Task2,       /* Function that implements the task. */
-                    "Task2",          /* Text name for the task. */
-                    100,      /* Stack size in words, not bytes. */
-                    ( void * ) 0,    /* Parameter passed into the task. */
-                    1,/* Priority at which the task is created. */
-                    &Task2Handler );      /* Used to pass out the created task's handle. */
-	xTaskCreate(
-                    Task3,       /* Function that implements the task. */
-                    "Task3",          /* Text name for the task. */
-                    100,      /* Stack size in words, not bytes. */
+                    prvPeriodicActionsTask,       /* Function that implements the task. */
+                    "Actions",          /* Text name for the task. */
+                    mainACTIONS_STACK_SIZE,      /* Stack size in words, not bytes. */
                     ( void * ) 0,    /* Parameter passed into the task. */
-                    1,/* Priority at which the task is created. */
-                    &Task3Handler );      /* Used to pass out the created task's handle. */
-	
+                    mainACTIONS_PRIORITY,/* Priority at which the task is created. */
+                    NULL );      /* The handle is not needed. */
+
 
 
 	/* Now all the tasks have been started - start the scheduler.
@@ -95,8 +95,75 @@ TaskHandle_t button2Handler = NULL;
 TaskHandle_t UARTHandler = NULL;
 TaskHandle_t PeriodicTaskHandler = NULL;
 
-/* Queue Handlers */
-QueueHandle_t xQueue1;
+/* Deadline Queue */
+
+/* Each message carries an absolute deadline (in ticks) and the UART task
+receives the message with the earliest deadline first, so a button edge is
+not held up behind the periodic strings.  The messages are kept in a binary
+min-heap, sending and receiving are O(log n).  Two queues of zero sized
+items count the messages and the free slots so the tasks block on them just
+as they did on a plain queue. */
+#define mainQUEUE_LENGTH			( 10 )
+#define mainMESSAGE_SIZE			( 32 )
+#define mainBUTTON_DEADLINE			( 20 )		/* An edge is printed within 20 ticks. */
+#define mainPERIODIC_DEADLINE		( 500 )		/* The periodic string can wait. */
+
+typedef struct
+{
+	TickType_t xDeadline;				/* Absolute deadline of the message. */
+	TickType_t xSourceTime;				/* Tick the chain started at, when the source sampled its input. */
+	UBaseType_t uxChain;				/* The chain the message belongs to, one of the mainCHAIN_ values. */
+	char cMessage[ mainMESSAGE_SIZE ];	/* The string to print. */
+} DeadlineMessage_t;
+
+typedef struct
+{
+	QueueHandle_t xMessages;			/* Holds one token per queued message. */
+	QueueHandle_t xSpaces;				/* Holds one token per free slot. */
+	UBaseType_t uxCount;				/* Number of messages in xHeap. */
+	DeadlineMessage_t xHeap[ mainQUEUE_LENGTH ];	/* Min-heap on xDeadline. */
+} DeadlineQueue_t;
+
+DeadlineQueue_t xQueue1;
+
+static BaseType_t xDeadlineQueueCreate( DeadlineQueue_t * pxQueue );
+static BaseType_t xDeadlineQueueSend( DeadlineQueue_t * pxQueue, const char * pcMessage, UBaseType_t uxChain, TickType_t xSourceTime, TickType_t xRelativeDeadline, TickType_t xTicksToWait );
+static BaseType_t xDeadlineQueueReceive( DeadlineQueue_t * pxQueue, char * pcBuffer, UBaseType_t * puxChain, TickType_t * pxSourceTime, TickType_t xTicksToWait );
+
+
+/* Chain Latency */
+
+/* The cause-effect chains of the pipeline: source task -> xQueue1 -> UART
+task -> vSerialPutString.  A chain is stamped when its source samples its
+input, the stamp travels with the message and the chain is closed once the
+UART task has handed the string to the serial driver.  The statistics are
+meant to be read in the debugger watch window. */
+#define mainCHAIN_BUTTON1			( 0 )		/* Edge on B1 to the UART. */
+#define mainCHAIN_BUTTON2			( 1 )		/* Edge on B2 to the UART. */
+#define mainCHAIN_PERIODIC			( 2 )		/* PeriodicTask string to the UART. */
+#define mainCHAIN_COUNT				( 3 )
+#define mainLATENCY_BUCKETS			( 8 )		/* The last bucket also counts everything longer. */
+#define mainLATENCY_BUCKET_WIDTH	( 10 )		/* Ticks per bucket. */
+
+typedef struct
+{
+	TickType_t xSourcePeriod;			/* How often the source samples, an event can wait this long before it is seen. */
+	uint32_t ulCount;					/* Number of messages that completed the chain. */
+	uint32_t ulTotalAge;				/* Sum of the data ages, divide by ulCount for the average. */
+	TickType_t xMinAge;					/* Shortest time from the source sample to the wire. */
+	TickType_t xMaxAge;					/* Worst-case data age, longest time from the source sample to the wire. */
+	TickType_t xMaxReaction;			/* Worst-case reaction, xMaxAge plus the source sampling period. */
+	uint32_t ulHistogram[ mainLATENCY_BUCKETS ];	/* Data ages in mainLATENCY_BUCKET_WIDTH tick buckets. */
+} ChainStats_t;
+
+ChainStats_t xChainStats[ mainCHAIN_COUNT ] =
+{
+	{ 10, 0, 0, portMAX_DELAY, 0, 0, { 0 } },	/* button1 polls every 10 ticks. */
+	{ 10, 0, 0, portMAX_DELAY, 0, 0, { 0 } },	/* button2 polls every 10 ticks. */
+	{ 100, 0, 0, portMAX_DELAY, 0, 0, { 0 } }	/* PeriodicTask sends every 100 ticks. */
+};
+
+static void prvChainClose( UBaseType_t uxChain, TickType_t xSourceTime );
 
 
 /* Global Variables */
@@ -110,10 +177,160 @@ int lastB1; /* Last Button1 Reading */
 int lastB2; /* Last Button2 Reading */
 int prevB1 = 1 ; /* Previous Button1 Reading ( starts with 1 by default at debugging) */
 int prevB2 = 1 ; /* Previous Button2 Reading ( starts with 1 by default at debugging) */
+TickType_t xB1SampleTime; /* Tick of the last Button1 Reading */
+TickType_t xB2SampleTime; /* Tick of the last Button2 Reading */
+
+
+
+
 
+/* True if message uxA of the heap is due before message uxB, the difference
+is signed so the comparison still holds when the tick count wraps. */
+#define prvDUE_BEFORE( pxQueue, uxA, uxB ) \
+	( ( BaseType_t ) ( ( pxQueue )->xHeap[ ( uxA ) ].xDeadline - ( pxQueue )->xHeap[ ( uxB ) ].xDeadline ) < 0 )
 
+static void prvHeapSwap( DeadlineQueue_t * pxQueue, UBaseType_t uxA, UBaseType_t uxB )
+{
+	DeadlineMessage_t xTemp = pxQueue->xHeap[ uxA ];
+
+	pxQueue->xHeap[ uxA ] = pxQueue->xHeap[ uxB ];
+	pxQueue->xHeap[ uxB ] = xTemp;
+}
+
+static BaseType_t xDeadlineQueueCreate( DeadlineQueue_t * pxQueue )
+{
+	UBaseType_t uxSlot;
 
+	pxQueue->uxCount = 0;
+	pxQueue->xMessages = xQueueCreate( mainQUEUE_LENGTH, 0 );
+	pxQueue->xSpaces = xQueueCreate( mainQUEUE_LENGTH, 0 );
 
+	if( ( pxQueue->xMessages == NULL ) || ( pxQueue->xSpaces == NULL ) )
+	{
+		return pdFAIL;
+	}
+
+	/* All the slots are free to start with. */
+	for( uxSlot = 0; uxSlot < mainQUEUE_LENGTH; uxSlot++ )
+	{
+		xQueueSend( pxQueue->xSpaces, NULL, 0 );
+	}
+
+	return pdPASS;
+}
+
+static BaseType_t xDeadlineQueueSend( DeadlineQueue_t * pxQueue, const char * pcMessage, UBaseType_t uxChain, TickType_t xSourceTime, TickType_t xRelativeDeadline, TickType_t xTicksToWait )
+{
+	UBaseType_t uxIndex;
+
+	/* Wait for a free slot. */
+	if( xQueueReceive( pxQueue->xSpaces, NULL, xTicksToWait ) != pdPASS )
+	{
+		return errQUEUE_FULL;
+	}
+
+	taskENTER_CRITICAL();
+	{
+		uxIndex = pxQueue->uxCount++;
+		/* The deadline is an end-to-end one, counted from the source sample. */
+		pxQueue->xHeap[ uxIndex ].xDeadline = xSourceTime + xRelativeDeadline;
+		pxQueue->xHeap[ uxIndex ].xSourceTime = xSourceTime;
+		pxQueue->xHeap[ uxIndex ].uxChain = uxChain;
+		memcpy( pxQueue->xHeap[ uxIndex ].cMessage, pcMessage, mainMESSAGE_SIZE );
+
+		/* Move the new message up to its place in the heap. */
+		while( ( uxIndex > 0 ) && prvDUE_BEFORE( pxQueue, uxIndex, ( uxIndex - 1 ) / 2 ) )
+		{
+			prvHeapSwap( pxQueue, uxIndex, ( uxIndex - 1 ) / 2 );
+			uxIndex = ( uxIndex - 1 ) / 2;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	/* Wake the receiver. */
+	xQueueSend( pxQueue->xMessages, NULL, 0 );
+
+	return pdPASS;
+}
+
+static BaseType_t xDeadlineQueueReceive( DeadlineQueue_t * pxQueue, char * pcBuffer, UBaseType_t * puxChain, TickType_t * pxSourceTime, TickType_t xTicksToWait )
+{
+	UBaseType_t uxIndex = 0, uxChild;
+
+	/* Wait for a message. */
+	if( xQueueReceive( pxQueue->xMessages, NULL, xTicksToWait ) != pdPASS )
+	{
+		return errQUEUE_EMPTY;
+	}
+
+	taskENTER_CRITICAL();
+	{
+		/* Take the earliest deadline message from the root, then move the
+		last message into the root and down to its place. */
+		memcpy( pcBuffer, pxQueue->xHeap[ 0 ].cMessage, mainMESSAGE_SIZE );
+		*puxChain = pxQueue->xHeap[ 0 ].uxChain;
+		*pxSourceTime = pxQueue->xHeap[ 0 ].xSourceTime;
+		pxQueue->uxCount--;
+		pxQueue->xHeap[ 0 ] = pxQueue->xHeap[ pxQueue->uxCount ];
+
+		for( ;; )
+		{
+			uxChild = ( 2 * uxIndex ) + 1;
+
+			if( uxChild >= pxQueue->uxCount )
+			{
+				break;
+			}
+
+			if( ( ( uxChild + 1 ) < pxQueue->uxCount ) && prvDUE_BEFORE( pxQueue, uxChild + 1, uxChild ) )
+			{
+				uxChild++;
+			}
+
+			if( !prvDUE_BEFORE( pxQueue, uxChild, uxIndex ) )
+			{
+				break;
+			}
+
+			prvHeapSwap( pxQueue, uxIndex, uxChild );
+			uxIndex = uxChild;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	/* Free the slot. */
+	xQueueSend( pxQueue->xSpaces, NULL, 0 );
+
+	return pdPASS;
+}
+
+/* Record the data age of a message that has reached the end of its chain. */
+static void prvChainClose( UBaseType_t uxChain, TickType_t xSourceTime )
+{
+	ChainStats_t * pxStats = &xChainStats[ uxChain ];
+	TickType_t xAge = xTaskGetTickCount() - xSourceTime;
+	UBaseType_t uxBucket = xAge / mainLATENCY_BUCKET_WIDTH;
+
+	if( uxBucket >= mainLATENCY_BUCKETS )
+	{
+		uxBucket = mainLATENCY_BUCKETS - 1;
+	}
+
+	pxStats->ulHistogram[ uxBucket ]++;
+	pxStats->ulCount++;
+	pxStats->ulTotalAge += xAge;
+
+	if( xAge < pxStats->xMinAge )
+	{
+		pxStats->xMinAge = xAge;
+	}
+
+	if( xAge > pxStats->xMaxAge )
+	{
+		pxStats->xMaxAge = xAge;
+		pxStats->xMaxReaction = xAge + pxStats->xSourcePeriod;
+	}
+}
 
 /* Task to be created. */
 
@@ -123,20 +340,22 @@ void button1( void * pvParameters )
     {
 		  /* read the pin value */
 			lastB1 = GPIO_read(PORT_0,PIN0); 
+			/* stamp the start of the chain */
+			xB1SampleTime = xTaskGetTickCount();
 			if(lastB1 != prevB1)
 			{
         /* an edge is deteced so now check if its rising or falling */
 				if(prevB1==1)
 				{
 					/* Send Falling edge string to queue */
-					xQueueSend( xQueue1, button1Falling, 0 );  
+					xDeadlineQueueSend( &xQueue1, button1Falling, mainCHAIN_BUTTON1, xB1SampleTime, mainBUTTON_DEADLINE, 0 );  
 					/* store the last pin value as the new previous value */
 					prevB1 = lastB1 ; 
 				}
 				else if(prevB1==0)
 				{
 					/* Send Rising edge string to queue */
-					xQueueSend( xQueue1, button1Rising, 0 ); 
+					xDeadlineQueueSend( &xQueue1, button1Rising, mainCHAIN_BUTTON1, xB1SampleTime, mainBUTTON_DEADLINE, 0 ); 
           /* store the last pin value as the new previous value	*/				
 					prevB1 = lastB1 ; // store the last pin value as the new previous value 
 				}
@@ -157,20 +376,22 @@ void button2( void * pvParameters )
     {
 			/* read the pin value */
 			lastB2 = GPIO_read(PORT_0,PIN1); 
+			/* stamp the start of the chain */
+			xB2SampleTime = xTaskGetTickCount();
 			if(lastB2 != prevB2)
 			{  
 				/* an edge is deteced so now check if its rising or falling */
 				if(prevB2==1)
 				{
 					/* Send Falling edge string to queue */
-					xQueueSend( xQueue1, button2Falling, 0 ); 
+					xDeadlineQueueSend( &xQueue1, button2Falling, mainCHAIN_BUTTON2, xB2SampleTime, mainBUTTON_DEADLINE, 0 ); 
 					/* store the last pin value as the new previous value */
 					prevB2 = lastB2 ; 
 				}
 				else if(prevB2==0)
 				{
 					/* Send Rising edge string to queue */
-					xQueueSend( xQueue1, button2Rising, 0 ); 
+					xDeadlineQueueSend( &xQueue1, button2Rising, mainCHAIN_BUTTON2, xB2SampleTime, mainBUTTON_DEADLINE, 0 ); 
 					/* store the last pin value as the new previous value */
 					prevB2 = lastB2 ; 
 				}
@@ -188,19 +409,24 @@ void PeriodicTask( void * pvParameters )
     for( ;; )
     {
 			/* Send Falling edge string to queue */
-		  xQueueSend( xQueue1, periodicstring, portMAX_DELAY ); 
+		  xDeadlineQueueSend( &xQueue1, periodicstring, mainCHAIN_PERIODIC, xTaskGetTickCount(), mainPERIODIC_DEADLINE, portMAX_DELAY ); 
 		  vTaskDelay(100);
     }
 }
 
 void UART( void * pvParameters )
 {
+	UBaseType_t uxChain;     /* chain of the received string */
+	TickType_t xSourceTime;  /* tick the chain of the received string started at */
+	
     for( ;; )
     {
-			/* Read String from the queue */
-			xQueueReceive(xQueue1,UARTstring, portMAX_DELAY ); 
+			/* Read the most urgent string from the queue */
+			xDeadlineQueueReceive( &xQueue1, UARTstring, &uxChain, &xSourceTime, portMAX_DELAY ); 
 			/* Print the string on UART */
 			vSerialPutString(UARTstring,sizeof(UARTstring));   
+			/* The string is on its way to the wire, close its chain */
+			prvChainClose( uxChain, xSourceTime );
 			vTaskDelay(20);
     }
 }
@@ -216,7 +442,7 @@ int main( void )
 	prvSetupHardware();
 	
 	/* Creating the queue */ 
-	xQueue1 = xQueueCreate( 10, sizeof( char[32] ));
+	xDeadlineQueueCreate( &xQueue1 );
 	
   /* Create Tasks here */
 	 xTaskCreate(